@@ -0,0 +1,191 @@
+#ifndef __clon_bench_hpp__
+#define __clon_bench_hpp__
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <iostream>
+
+#include "format.hpp"
+
+namespace clon::bench
+{
+  using clock = std::chrono::steady_clock;
+
+  constexpr std::size_t default_warmup = 3;
+  constexpr std::size_t default_samples = 31;
+  constexpr std::size_t min_sample_ns = 200000;
+
+  template <typename type_t>
+  void keep(const type_t &value)
+  {
+    asm volatile(""
+                 :
+                 : "g"(&value)
+                 : "memory");
+  }
+
+  struct stats
+  {
+    std::size_t min = 0;
+    std::size_t median = 0;
+    std::size_t p99 = 0;
+    std::size_t samples = 0;
+    std::size_t batch = 0;
+  };
+
+  inline stats make_stats(
+      std::vector<std::size_t> &times,
+      const std::size_t &batch)
+  {
+    stats s;
+
+    std::sort(times.begin(), times.end());
+    s.samples = times.size();
+    s.batch = batch;
+    s.min = times.front();
+    s.median = times[times.size() / 2];
+    s.p99 = times[std::min(times.size() - 1, (times.size() * 99) / 100)];
+
+    return s;
+  }
+
+  template <typename func_t>
+  std::size_t time_batch(func_t &func, const std::size_t &batch)
+  {
+    auto &&start = clock::now();
+
+    for (std::size_t i = 0; i < batch; ++i)
+      func();
+
+    auto &&stop = clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+  }
+
+  template <typename func_t>
+  std::size_t calibrate(func_t &func)
+  {
+    std::size_t batch = 1;
+
+    while (time_batch(func, batch) < min_sample_ns and batch < (1u << 24))
+      batch *= 2;
+
+    return batch;
+  }
+
+  template <typename func_t>
+  stats measure(
+      func_t &&func,
+      const std::size_t &warmup = default_warmup,
+      const std::size_t &samples = default_samples)
+  {
+    for (std::size_t i = 0; i < warmup; ++i)
+      func();
+
+    const std::size_t batch = calibrate(func);
+    std::vector<std::size_t> times;
+    times.reserve(samples);
+
+    for (std::size_t i = 0; i < samples; ++i)
+      times.push_back(time_batch(func, batch) / batch);
+
+    return make_stats(times, batch);
+  }
+
+  template <typename setup_t, typename func_t>
+  stats measure_with_setup(
+      setup_t &&setup,
+      func_t &&func,
+      const std::size_t &warmup = default_warmup,
+      const std::size_t &samples = default_samples)
+  {
+    for (std::size_t i = 0; i < warmup; ++i)
+    {
+      auto &&state = setup();
+      func(state);
+    }
+
+    std::vector<std::size_t> times;
+    times.reserve(samples);
+
+    for (std::size_t i = 0; i < samples; ++i)
+    {
+      auto &&state = setup();
+      auto &&start = clock::now();
+      func(state);
+      auto &&stop = clock::now();
+      times.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+    }
+
+    return make_stats(times, 1);
+  }
+
+  inline std::size_t per_second(
+      const std::size_t &count,
+      const std::size_t &ns)
+  {
+    return ns == 0 ? 0 : static_cast<std::size_t>((count * 1e9) / ns);
+  }
+
+  class reporter
+  {
+    std::string_view filter;
+
+  public:
+    explicit reporter(std::string_view _filter = "")
+        : filter(_filter)
+    {
+      std::cout << fmt::format(
+          "{}\t{}\t{}\t{}\t{}\t{}\t{}\n",
+          "name", "min_ns", "median_ns", "p99_ns",
+          "mb_per_s", "items_per_s", "batch");
+    }
+
+  public:
+    bool enabled(std::string_view name) const
+    {
+      return filter.empty() or name.find(filter) != std::string_view::npos;
+    }
+
+    void report(
+        std::string_view name,
+        const stats &s,
+        const std::size_t &bytes = 0,
+        const std::size_t &items = 0) const
+    {
+      std::cout << fmt::format(
+          "{}\t{}\t{}\t{}\t{}\t{}\t{}\n",
+          name, s.min, s.median, s.p99,
+          per_second(bytes, s.median) / 1000000,
+          per_second(items, s.median), s.batch);
+    }
+
+    template <typename func_t>
+    void run(
+        std::string_view name,
+        func_t &&func,
+        const std::size_t &bytes = 0,
+        const std::size_t &items = 0) const
+    {
+      if (enabled(name))
+        report(name, measure(func), bytes, items);
+    }
+
+    template <typename setup_t, typename func_t>
+    void run_with_setup(
+        std::string_view name,
+        setup_t &&setup,
+        func_t &&func,
+        const std::size_t &bytes = 0,
+        const std::size_t &items = 0) const
+    {
+      if (enabled(name))
+        report(name, measure_with_setup(setup, func), bytes, items);
+    }
+  };
+}
+
+#endif
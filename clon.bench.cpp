@@ -0,0 +1,863 @@
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <memory_resource>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+
+#include "clon.hpp"
+#include "bench.hpp"
+
+// every heap allocation of the bench goes through here to be counted,
+// from any thread since parse_many and the parallel benches allocate too.
+namespace heap
+{
+  std::atomic<std::size_t> allocations = 0;
+}
+
+void *operator new(std::size_t n)
+{
+  heap::allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void *p = std::malloc(n))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t n, std::align_val_t al)
+{
+  heap::allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void *p = std::aligned_alloc(std::size_t(al), (n + std::size_t(al) - 1) & ~(std::size_t(al) - 1)))
+    return p;
+
+  throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+namespace gen
+{
+  std::string deep(const std::size_t &depth)
+  {
+    std::string s;
+
+    for (std::size_t i = 0; i < depth; ++i)
+      s += "(level ";
+
+    s += "(leaf 42)";
+    s += std::string(depth, ')');
+
+    return s;
+  }
+
+  std::string wide(const std::size_t &rows)
+  {
+    std::string s = "(table ";
+
+    for (std::size_t i = 0; i < rows; ++i)
+      s += clon::fmt::format(
+          "(row (id {}) (name \"row number {}\") (active {}) (address (city \"Manchester\") (postal {})))",
+          i, i, std::string_view(i % 2 == 0 ? "true" : "false"), 10000 + i);
+
+    s += ")";
+    return s;
+  }
+
+  std::string strings(const std::size_t &count)
+  {
+    std::string s = "(texts ";
+
+    for (std::size_t i = 0; i < count; ++i)
+      s += clon::fmt::format(
+          "(text \"{} Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor\")", i);
+
+    s += ")";
+    return s;
+  }
+
+  std::string numbers(const std::size_t &count)
+  {
+    std::string s = "(numbers ";
+
+    for (std::size_t i = 0; i < count; ++i)
+      s += clon::fmt::format("(n {})", (i * 2654435761u) % 1000000000000u);
+
+    s += ")";
+    return s;
+  }
+}
+
+namespace gen
+{
+  std::string documents(const std::size_t &count)
+  {
+    std::string s;
+
+    for (std::size_t i = 0; i < count; ++i)
+      s += clon::fmt::format(
+          "(event (id {}) (user \"user {}\") (amount -{}.25) (tags (tag \"a\") (tag \"b\")))\n", i, i % 97, i % 1000);
+
+    return s;
+  }
+
+  std::string reals(const std::size_t &count)
+  {
+    std::string s = "(reals ";
+
+    for (std::size_t i = 0; i < count; ++i)
+      s += clon::fmt::format(
+          "(r {}) (n -{})", (i * 2654435761u % 1000000) / 997.0 + 0.5, i * 2654435761u % 1000000007u);
+
+    s += ")";
+    return s;
+  }
+}
+
+std::size_t count_nodes(std::string_view data)
+{
+  return std::count(data.begin(), data.end(), '(');
+}
+
+void bench_parse(
+    const clon::bench::reporter &rep,
+    std::string_view name,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data);
+
+  rep.run(
+      name, [data] { clon::clon a(data); clon::bench::keep(a); },
+      data.size(), nodes);
+}
+
+struct counting_visitor
+{
+  std::size_t nodes = 0;
+  std::size_t values = 0;
+
+  void on_open(std::string_view) { ++nodes; }
+  void on_boolean(std::string_view) { ++values; }
+  void on_number(std::string_view) { ++values; }
+  void on_string(std::string_view) { ++values; }
+  void on_close() {}
+};
+
+void bench_events(
+    const clon::bench::reporter &rep,
+    std::string_view name,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data);
+
+  rep.run(
+      name, [data] {
+        counting_visitor visitor;
+        clon::parse_events(data, visitor);
+        clon::bench::keep(visitor); },
+      data.size(), nodes);
+}
+
+void bench_interned(
+    const clon::bench::reporter &rep,
+    std::string_view name,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data);
+  clon::name_table names;
+
+  rep.run(
+      name, [data, &names] { clon::clon a(data, {&names}); clon::bench::keep(a); },
+      data.size(), nodes);
+}
+
+void bench_stream(
+    const clon::bench::reporter &rep,
+    std::string_view name,
+    std::string_view data,
+    const std::size_t &chunk)
+{
+  const std::size_t nodes = count_nodes(data);
+
+  rep.run(
+      name, [data, chunk] {
+        clon::clon_stream stream;
+        for (std::size_t i = 0; i < data.size(); i += chunk)
+          stream.feed(data.substr(i, chunk));
+        clon::clon a = stream.finish();
+        clon::bench::keep(a); },
+      data.size(), nodes);
+}
+
+void bench_many(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data);
+  const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t base = 0;
+
+  for (std::size_t threads = 1; threads <= std::max<std::size_t>(cores, 4); threads *= 2)
+  {
+    const std::string name = clon::fmt::format("many/threads:{}", threads);
+
+    if (not rep.enabled(name))
+      continue;
+
+    const clon::bench::stats s = clon::bench::measure([data, threads] {
+      auto &&docs = clon::clon::parse_many(data, threads);
+      clon::bench::keep(docs); });
+
+    base = threads == 1 ? s.median : base;
+    rep.report(name, s, data.size(), nodes);
+
+    if (base != 0)
+      std::cout << clon::fmt::format(
+          "many/speedup:{}\t{}%\tof {} cores\n", threads, (base * 100) / s.median, cores);
+  }
+}
+
+void bench_parallel(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data);
+  const std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t base = 0;
+
+  for (std::size_t threads = 1; threads <= std::max<std::size_t>(cores, 4); threads *= 2)
+  {
+    const std::string name = clon::fmt::format("parallel/threads:{}", threads);
+
+    if (not rep.enabled(name))
+      continue;
+
+    const clon::bench::stats s = clon::bench::measure([data, threads] {
+      clon::clon c(data, {.threads = threads});
+      clon::bench::keep(c); });
+
+    base = threads == 1 ? s.median : base;
+    rep.report(name, s, data.size(), nodes);
+
+    if (base != 0)
+      std::cout << clon::fmt::format(
+          "parallel/speedup:{}\t{}%\tof {} cores\n", threads, (base * 100) / s.median, cores);
+  }
+}
+
+void bench_reuse(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  const std::vector<std::string_view> messages = clon::detail::split_documents(data);
+  const std::size_t nodes = count_nodes(data);
+
+  clon::parser p;
+  clon::clon doc = p.parse(messages.front());
+
+  auto &&fresh = [&messages] {
+    for (std::string_view message : messages)
+    {
+      clon::clon c(message);
+      clon::bench::keep(c);
+    } };
+
+  auto &&reused = [&messages, &p, &doc] {
+    for (std::string_view message : messages)
+    {
+      p.parse_into(doc, message);
+      clon::bench::keep(doc);
+    } };
+
+  auto &&run = [&](std::string_view name, auto &&func) {
+    if (not rep.enabled(name))
+      return;
+
+    rep.report(name, clon::bench::measure(func), data.size(), nodes);
+
+    const std::size_t before = heap::allocations.load(std::memory_order_relaxed);
+    func();
+    std::cout << clon::fmt::format(
+        "{}:allocations\t{}\tper message\n", name, (heap::allocations.load(std::memory_order_relaxed) - before) / messages.size());
+  };
+
+  run("reuse/fresh", fresh);
+  run("reuse/parse_into", reused);
+}
+
+void bench_structurals(
+    const clon::bench::reporter &rep,
+    std::string_view shape,
+    std::string_view data)
+{
+  namespace detail = clon::detail;
+  std::vector<std::size_t> index;
+
+  auto &&run = [&](std::string_view level_name, detail::simd_level level) {
+    rep.run(
+        clon::fmt::format("structurals/{}:{}", shape, level_name), [&] { detail::find_structurals(data, index, level); clon::bench::keep(index); },
+        data.size(), data.size());
+  };
+
+  run("scalar", detail::simd_level::scalar);
+  run("sse2", detail::simd_level::sse2);
+
+  if (detail::best_simd_level == detail::simd_level::avx2)
+    run("avx2", detail::simd_level::avx2);
+}
+
+void bench_load(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  const char *path = "clon.bench.tmp";
+  std::ofstream(path) << data;
+  const std::size_t nodes = count_nodes(data);
+
+  rep.run(
+      "load/read-then-parse", [path] {
+        std::ifstream in(path);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        clon::clon a(std::move(content));
+        clon::bench::keep(a); },
+      data.size(), nodes);
+
+  rep.run(
+      "load/from-file", [path] {
+        clon::clon a = clon::clon::from_file(path);
+        clon::bench::keep(a); },
+      data.size(), nodes);
+
+  std::remove(path);
+}
+
+void bench_lookup(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  clon::clon a(data);
+
+  rep.run(
+      "lookup/first", [&a] { clon::bench::keep(a["row.address.postal"]); },
+      0, 1);
+  rep.run(
+      "lookup/indexed:500", [&a] { clon::bench::keep(a["row:500.address.postal"]); },
+      0, 1);
+  rep.run(
+      "lookup/indexed:4999", [&a] { clon::bench::keep(a["row:4999.id"]); },
+      0, 1);
+
+  using namespace clon::literals;
+  const clon::compiled_path first("row.address.postal");
+  const clon::compiled_path indexed("row:500.address.postal");
+
+  rep.run(
+      "lookup/compiled:first", [&] { clon::bench::keep(a[first]); },
+      0, 1);
+  rep.run(
+      "lookup/compiled:indexed:500", [&] { clon::bench::keep(a[indexed]); },
+      0, 1);
+  clon::name_table names;
+  clon::clon b(data, {&names});
+  clon::compiled_path bound_first("row.address.postal");
+  clon::compiled_path bound_indexed("row:500.address.postal");
+  bound_first.bind(names);
+  bound_indexed.bind(names);
+
+  rep.run(
+      "lookup/interned:first", [&] { clon::bench::keep(b[bound_first]); },
+      0, 1);
+  rep.run(
+      "lookup/interned:indexed:500", [&] { clon::bench::keep(b[bound_indexed]); },
+      0, 1);
+
+  clon::clon c(data, {.index_lists = true});
+  c["row:0"];
+
+  rep.run(
+      "lookup/index:indexed:500", [&c] { clon::bench::keep(c["row:500.address.postal"]); },
+      0, 1);
+  rep.run(
+      "lookup/index:indexed:4999", [&c] { clon::bench::keep(c["row:4999.id"]); },
+      0, 1);
+
+  rep.run(
+      "lookup/static:first", [&a] { clon::bench::keep(a["row.address.postal"_path]); },
+      0, 1);
+  rep.run(
+      "lookup/static:indexed:500", [&a] { clon::bench::keep(a["row:500.address.postal"_path]); },
+      0, 1);
+}
+
+void bench_select(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  clon::clon a(data);
+
+  rep.run(
+      "select/loop:1000", [&a] {
+        for (std::size_t i = 0; i < 1000; ++i)
+          clon::bench::keep(a[clon::fmt::format("row:{}.address.postal", i)]); },
+      0, 1000);
+  rep.run(
+      "select/range:1000", [&a] {
+        for (auto &&postal : a.select("row:0-999.address.postal"))
+          clon::bench::keep(postal); },
+      0, 1000);
+  rep.run(
+      "select/all", [&a] {
+        for (auto &&postal : a.select("row:*.address.postal"))
+          clon::bench::keep(postal); },
+      0, 5000);
+}
+
+void bench_numbers(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data) - 1;
+
+  auto &&read_all = [data](const clon::parse_options &opts) {
+    clon::clon a(data, opts);
+    clon::real sum = 0;
+
+    for (auto &&r : a.select("r:*"))
+      sum += r.template as_<clon::real>();
+
+    for (auto &&n : a.select("n:*"))
+      sum += n.template as_<clon::number>();
+
+    clon::bench::keep(sum);
+  };
+
+  rep.run("numbers/parse:signed-and-real", [data] { clon::clon a(data); clon::bench::keep(a); }, data.size(), nodes);
+  rep.run("numbers/read-all:lazy", [&] { read_all({}); }, data.size(), nodes);
+  rep.run("numbers/read-all:eager", [&] { read_all({.eager_values = true}); }, data.size(), nodes);
+}
+
+void bench_compact(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data);
+
+  rep.run(
+      "compact/parse", [data] { clon::compact_clon c(data); clon::bench::keep(c); },
+      data.size(), nodes);
+
+  namespace detail = clon::detail;
+  detail::root_node<char> root = detail::parse(data);
+  detail::tape<char> tape;
+  tape.buff = data;
+  detail::parse(tape);
+
+  auto &&walk = [](const auto &view) {
+    std::size_t length = 0;
+
+    for (auto &&child : clon::detail::childs(view))
+      length += child.name().size();
+
+    clon::bench::keep(length);
+  };
+
+  rep.run(
+      "compact/walk:nodes", [&] { walk(detail::make_rview(root)); },
+      0, nodes);
+  rep.run(
+      "compact/walk:tape", [&] { walk(detail::tape_view<char>{&tape, 0}); },
+      0, nodes);
+  clon::compact_clon c(data);
+
+  rep.run(
+      "compact/lookup:indexed:500", [&c] { clon::bench::keep(c["row:500.address.postal"]); },
+      0, 1);
+}
+
+void bench_arena(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data);
+  std::pmr::unsynchronized_pool_resource pool;
+
+  rep.run(
+      "arena/small:default", [data] {
+        clon::clon a(data);
+        clon::bench::keep(a); },
+      data.size(), nodes);
+
+  rep.run(
+      "arena/small:pool", [data, &pool] {
+        clon::clon a(data, {.resource = &pool});
+        clon::bench::keep(a); },
+      data.size(), nodes);
+
+  clon::clon a(data);
+  auto &&name = a["name"];
+
+  rep.run(
+      "arena/update", [&name] {
+        name.update<clon::string<char>>("Paulo");
+        clon::bench::keep(name); },
+      0, 1);
+}
+
+void bench_as(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  namespace detail = clon::detail;
+  const std::size_t nodes = count_nodes(data) - 1;
+
+  auto &&setup = [data]() -> detail::root_node<char> { return detail::parse(data); };
+
+  auto &&decode = [](detail::root_node<char> &root) {
+    for (auto &&child : detail::childs(detail::make_rview(root)))
+      clon::bench::keep(child.template as_<clon::number>());
+  };
+
+  rep.run_with_setup("as/number:lazy-first", setup, decode, 0, nodes);
+
+  detail::root_node<char> root = detail::parse(data);
+  decode(root);
+  rep.run("as/number:cached", [&] { decode(root); }, 0, nodes);
+
+  auto &&read_all = [data](const clon::parse_options &opts) {
+    clon::clon a(data, opts);
+    std::size_t sum = 0;
+
+    for (auto &&n : a.select("n:*"))
+      sum += n.template as_<clon::number>();
+
+    clon::bench::keep(sum);
+  };
+
+  auto &&read_few = [data](const clon::parse_options &opts) {
+    clon::clon a(data, opts);
+    std::size_t sum = 0;
+
+    for (auto &&n : a.select("n:0-9"))
+      sum += n.template as_<clon::number>();
+
+    clon::bench::keep(sum);
+  };
+
+  rep.run("as/read-all:lazy", [&] { read_all({}); }, data.size(), nodes);
+  rep.run("as/read-all:eager", [&] { read_all({.eager_values = true}); }, data.size(), nodes);
+  rep.run("as/read-few:lazy", [&] { read_few({}); }, data.size(), nodes);
+  rep.run("as/read-few:eager", [&] { read_few({.eager_values = true}); }, data.size(), nodes);
+}
+
+void bench_format(
+    const clon::bench::reporter &rep,
+    std::string_view name,
+    std::string_view data)
+{
+  clon::clon a(data);
+  const std::size_t nodes = count_nodes(data);
+
+  rep.run(
+      name, [&a] { clon::bench::keep(clon::fmt::format("{}", a)); },
+      data.size(), nodes);
+}
+
+// loading the binary layout only checks it, against parsing the text into
+// nodes or into the tape.
+void bench_binary(
+    const clon::bench::reporter &rep,
+    std::string_view name,
+    std::string_view data)
+{
+  const std::size_t nodes = count_nodes(data);
+  const clon::clon a(data);
+  const std::string bin = a.write_binary();
+  const std::string dict = a.write_binary({.dictionary = true});
+  const std::string prefix = "binary/" + std::string(name);
+
+  rep.run(
+      prefix + ":parse-text", [data] { clon::clon c(data); clon::bench::keep(c); },
+      data.size(), nodes);
+  rep.run(
+      prefix + ":parse-compact", [data] { clon::compact_clon c(data); clon::bench::keep(c); },
+      data.size(), nodes);
+  rep.run(
+      prefix + ":load", [&bin] { clon::binary_clon b{std::string_view(bin)}; clon::bench::keep(b); },
+      bin.size(), nodes);
+  rep.run(
+      prefix + ":load-dictionary", [&dict] { clon::binary_clon b{std::string_view(dict)}; clon::bench::keep(b); },
+      dict.size(), nodes);
+  rep.run(
+      prefix + ":write", [&a] { clon::bench::keep(a.write_binary()); },
+      data.size(), nodes);
+
+  const clon::binary_clon b{std::string_view(bin)};
+
+  rep.run(
+      prefix + ":to-text", [&b] { clon::bench::keep(b.write()); },
+      data.size(), nodes);
+}
+
+void bench_binary_lookup(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  const clon::clon a(data);
+  const clon::binary_clon b(a.write_binary());
+
+  rep.run(
+      "binary/lookup:first", [&b] { clon::bench::keep(b["row.address.postal"]); },
+      0, 1);
+  rep.run(
+      "binary/lookup:indexed:500", [&b] { clon::bench::keep(b["row:500.address.postal"]); },
+      0, 1);
+  rep.run(
+      "binary/lookup:indexed:4999", [&b] { clon::bench::keep(b["row:4999.id"]); },
+      0, 1);
+}
+
+void bench_fmt(const clon::bench::reporter &rep)
+{
+  using namespace clon::fmt::literals;
+
+  const std::string_view level = "info";
+  const std::string_view message = "document parsed";
+  const std::size_t nodes = 5000;
+  const std::size_t depth = 12;
+
+  rep.run(
+      "fmt/log:runtime", [&] { clon::bench::keep(clon::fmt::format("[{}] {} : {} nodes read from the document, {} levels deep", level, message, nodes, depth)); },
+      0, 1);
+  rep.run(
+      "fmt/log:compiled", [&] { clon::bench::keep(clon::fmt::format("[{}] {} : {} nodes read from the document, {} levels deep"_fmt, level, message, nodes, depth)); },
+      0, 1);
+
+  char line[256];
+
+  rep.run(
+      "fmt/log:span", [&] { clon::bench::keep(clon::fmt::format_to_n(line, "[{}] {} : {} nodes read from the document, {} levels deep"_fmt, level, message, nodes, depth)); },
+      0, 1);
+}
+
+// the same values through clon::fmt, std::to_chars and snprintf, each
+// into a stack buffer.
+template <typename value_t>
+void bench_to_text(
+    const clon::bench::reporter &rep,
+    std::string_view name,
+    const std::vector<value_t> &values,
+    const char *printf_format)
+{
+  char out[64];
+  clon::fmt::formatter_context<char> ctx{std::span<char>(out)};
+
+  rep.run(
+      std::string(name) + ":fmt", [&] {
+        for (const value_t &v : values)
+        {
+          ctx.rewind();
+          clon::fmt::format_of(ctx, v);
+          clon::bench::keep(out);
+        }
+      },
+      0, values.size());
+  rep.run(
+      std::string(name) + ":to_chars", [&] {
+        for (const value_t &v : values)
+        {
+          std::to_chars(out, out + sizeof(out), v);
+          clon::bench::keep(out);
+        }
+      },
+      0, values.size());
+  rep.run(
+      std::string(name) + ":snprintf", [&] {
+        for (const value_t &v : values)
+        {
+          std::snprintf(out, sizeof(out), printf_format, v);
+          clon::bench::keep(out);
+        }
+      },
+      0, values.size());
+}
+
+void bench_to_text(const clon::bench::reporter &rep)
+{
+  std::vector<long long> integers;
+  std::vector<double> reals;
+  std::uint64_t seed = 42;
+
+  for (std::size_t i = 0; i < 10000; ++i)
+  {
+    seed = seed * 6364136223846793005u + 1442695040888963407u;
+    const long long v = static_cast<long long>(seed >> (seed % 64));
+    integers.push_back(i % 2 == 0 ? v : -v);
+    reals.push_back(static_cast<double>(v) / static_cast<double>((seed >> 40) | 1));
+  }
+
+  bench_to_text(rep, "to_text/integers", integers, "%lld");
+  bench_to_text(rep, "to_text/reals", reals, "%.17g");
+
+  char out[32];
+  clon::fmt::formatter_context<char> ctx{std::span<char>(out)};
+
+  rep.run(
+      "to_text/hex:fmt", [&] {
+        for (const long long &v : integers)
+        {
+          ctx.rewind();
+          clon::fmt::format_of(ctx, clon::fmt::hex(v));
+          clon::bench::keep(out);
+        }
+      },
+      0, integers.size());
+  rep.run(
+      "to_text/hex:to_chars", [&] {
+        for (const long long &v : integers)
+        {
+          std::to_chars(out, out + sizeof(out), v, 16);
+          clon::bench::keep(out);
+        }
+      },
+      0, integers.size());
+}
+
+// the whole document to /dev/null, through a string first or streamed
+// through the block of a file_context.
+void bench_sink(
+    const clon::bench::reporter &rep,
+    std::string_view data)
+{
+  clon::clon a(data);
+  const std::size_t nodes = count_nodes(data);
+  std::FILE *null = std::fopen("/dev/null", "w");
+
+  if (null == nullptr)
+    return;
+
+  rep.run(
+      "sink/wide:string+fwrite", [&] {
+        const std::string text = clon::fmt::format("{}", a);
+        std::fwrite(text.data(), 1, text.size(), null);
+      },
+      data.size(), nodes);
+  rep.run(
+      "sink/wide:format_to", [&] { clon::fmt::format_to(null, "{}", a); },
+      data.size(), nodes);
+  rep.run(
+      "sink/wide:write_to", [&] {
+        clon::fmt::file_context<> ctx(null);
+        a.write_to(ctx);
+      },
+      data.size(), nodes);
+
+  std::fclose(null);
+}
+
+void bench_write(
+    const clon::bench::reporter &rep,
+    std::string_view name,
+    std::string_view data)
+{
+  clon::clon a(data);
+  const std::size_t nodes = count_nodes(data);
+  std::string out(a.write_length(clon::write_mode::pretty), '\0');
+
+  rep.run(
+      std::string(name) + ":compact",
+      [&a] { clon::bench::keep(a.write()); },
+      data.size(), nodes);
+  rep.run(
+      std::string(name) + ":pretty",
+      [&a] { clon::bench::keep(a.write(clon::write_mode::pretty)); },
+      data.size(), nodes);
+  rep.run(
+      std::string(name) + ":into",
+      [&a, &out] { clon::bench::keep(a.write_into(out.data(), clon::write_mode::pretty)); },
+      data.size(), nodes);
+}
+
+int main(int argc, char **argv)
+{
+  clon::bench::reporter rep(argc > 1 ? argv[1] : "");
+
+  const std::string deep = gen::deep(2000);
+  const std::string deeper = gen::deep(20000);
+  const std::string wide = gen::wide(5000);
+  const std::string strings = gen::strings(10000);
+  const std::string numbers = gen::numbers(50000);
+  const std::string reals = gen::reals(25000);
+  const std::string documents = gen::documents(20000);
+  const std::string huge = gen::wide(100000);
+  const std::string small = "(person (name \"Paul\") (age 35) (address (city \"Manchester\") (postal 82910)))";
+
+  bench_parse(rep, "parse/deep", deep);
+  bench_parse(rep, "parse/deep:20000", deeper);
+  bench_parse(rep, "parse/wide", wide);
+  bench_parse(rep, "parse/strings", strings);
+  bench_parse(rep, "parse/numbers", numbers);
+
+  bench_interned(rep, "parse/wide:interned", wide);
+
+  bench_events(rep, "events/wide", wide);
+  bench_events(rep, "events/numbers", numbers);
+
+  bench_stream(rep, "stream/wide:4096", wide, 4096);
+  bench_stream(rep, "stream/strings:4096", strings, 4096);
+
+  bench_many(rep, documents);
+  bench_parallel(rep, huge);
+  bench_reuse(rep, documents);
+
+  bench_structurals(rep, "strings", strings);
+  bench_structurals(rep, "numbers", numbers);
+  bench_load(rep, wide);
+  bench_lookup(rep, wide);
+  bench_select(rep, wide);
+  bench_compact(rep, wide);
+  bench_as(rep, numbers);
+  bench_arena(rep, small);
+  bench_numbers(rep, reals);
+
+  bench_format(rep, "format/wide", wide);
+  bench_format(rep, "format/deep:20000", deeper);
+  bench_format(rep, "format/numbers", numbers);
+
+  bench_binary(rep, "wide", wide);
+  bench_binary_lookup(rep, wide);
+  bench_binary(rep, "numbers", numbers);
+  bench_binary(rep, "strings", strings);
+
+  bench_fmt(rep);
+  bench_to_text(rep);
+
+  bench_sink(rep, wide);
+
+  bench_write(rep, "write/wide", wide);
+  bench_write(rep, "write/numbers", numbers);
+
+  return EXIT_SUCCESS;
+}
@@ -9,6 +9,35 @@
 #include <limits>
 #include <array>
 #include <stdexcept>
+#include <memory>
+#include <utility>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <bit>
+#include <cstring>
+#include <cmath>
+#include <charconv>
+#include <deque>
+#include <unordered_map>
+#include <iterator>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <memory_resource>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CLON_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#if __has_include(<sys/mman.h>)
+#define CLON_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include "format.hpp"
 
@@ -23,7 +52,15 @@ namespace clon::detail
     list = 4,
     no_boolean = 5,
     no_number = 6,
-    no_string = 7
+    no_string = 7,
+    real = 8,
+    no_real = 9
+  };
+
+  enum struct write_mode : int
+  {
+    compact,
+    pretty
   };
 
   struct list_tag
@@ -42,6 +79,10 @@ namespace clon::detail
   {
   };
 
+  struct no_real_tag
+  {
+  };
+
   template <typename char_t>
   using string = std::basic_string_view<char_t>;
   using none = std::monostate;
@@ -51,11 +92,13 @@ namespace clon::detail
   using no_number = no_number_tag;
   using no_string = no_string_tag;
   using no_boolean = no_boolean_tag;
+  using real = double;
+  using no_real = no_real_tag;
 
   template <typename char_t>
   using value = std::variant<
       none, boolean, number, string<char_t>, list,
-      no_boolean, no_number, no_string>;
+      no_boolean, no_number, no_string, real, no_real>;
 
   template <std::integral t>
   constexpr t maxof = std::numeric_limits<t>::max();
@@ -63,20 +106,113 @@ namespace clon::detail
   constexpr std::size_t no_next = maxof<std::size_t>;
   constexpr std::size_t no_child = maxof<std::size_t>;
   constexpr std::size_t no_root = maxof<std::size_t>;
+  constexpr std::uint32_t no_name = maxof<std::uint32_t>;
+  constexpr std::size_t default_max_depth = 1 << 16;
+
+  // eight ascii digits at once in a 64 bits word : pairs, then quads, then
+  // the whole word are combined with a multiply each.
+  inline std::uint64_t eight_digits_of(const char *p)
+  {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+         (((v >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+        32;
+    return v;
+  }
+
+  inline void handle_out_of_range()
+  {
+    throw std::runtime_error("number out of range");
+  }
+
+  inline void handle_bad_real()
+  {
+    throw std::runtime_error("malformed real");
+  }
+
+  inline void handle_too_deep()
+  {
+    throw std::runtime_error("nodes nested deeper than max_depth");
+  }
 
   template <typename char_t>
   number to_number(std::basic_string_view<char_t> v)
   {
-    number n = 0;
+    const bool negative = not v.empty() and v.front() == '-';
+    std::uint64_t n = 0;
+    bool overflow = false;
+
+    if (negative)
+      v.remove_prefix(1);
+
+    if constexpr (std::is_same_v<char_t, char> and
+                  std::endian::native == std::endian::little)
+      while (v.size() >= 8)
+      {
+        overflow |= __builtin_mul_overflow(n, 100000000u, &n);
+        overflow |= __builtin_add_overflow(n, eight_digits_of(v.data()), &n);
+        v.remove_prefix(8);
+      }
 
     for (const char_t &c : v)
-      n = n * 10 + (c - '0');
+    {
+      overflow |= __builtin_mul_overflow(n, 10u, &n);
+      overflow |= __builtin_add_overflow(n, static_cast<std::uint64_t>(c - '0'), &n);
+    }
 
-    return n;
+    const std::uint64_t limit = static_cast<std::uint64_t>(maxof<number>) + negative;
+
+    if (overflow or n > limit)
+      handle_out_of_range();
+
+    return negative
+               ? static_cast<number>(0 - n)
+               : static_cast<number>(n);
+  }
+
+  template <typename char_t>
+  real to_real(const std::basic_string_view<char_t> &v)
+  {
+    real r = 0;
+
+    if constexpr (std::is_same_v<char_t, char>)
+    {
+      auto &&res = std::from_chars(v.data(), v.data() + v.size(), r);
+
+      if (res.ec == std::errc::result_out_of_range)
+        handle_out_of_range();
+
+      if (res.ec != std::errc() or res.ptr != v.data() + v.size() or not std::isfinite(r))
+        handle_bad_real();
+    }
+    else
+      r = to_real(std::string_view(std::string(v.begin(), v.end())));
+
+    return r;
+  }
+
+  template <typename char_t>
+  bool to_boolean(const std::basic_string_view<char_t> &v)
+  {
+    constexpr char_t yes[] = {'t', 'r', 'u', 'e'};
+    return v == std::basic_string_view<char_t>(yes, 4);
+  }
+
+  template <typename char_t>
+  bool is_real(const std::basic_string_view<char_t> &v)
+  {
+    for (const char_t &c : v)
+      if (c == '.' or c == 'e' or c == 'E')
+        return true;
+
+    return false;
   }
 
   template <typename char_t>
-  std::size_t to_integer(std::basic_string_view<char_t> v)
+  constexpr std::size_t to_integer(std::basic_string_view<char_t> v)
   {
     std::size_t n = 0;
 
@@ -121,6 +257,10 @@ namespace clon::detail
     case clon_type::no_string:
       n.val = no_string{};
       break;
+    case clon_type::real:
+    case clon_type::no_real:
+      n.val = no_real{};
+      break;
     case clon_type::list:
       n.val = list{};
       break;
@@ -132,21 +272,286 @@ namespace clon::detail
     return n;
   }
 
+  template <typename char_t>
+  class mapped_file
+  {
+    const char_t *addr = nullptr;
+    std::size_t length = 0;
+
+  public:
+    explicit mapped_file(const std::string &path)
+    {
+#ifdef CLON_HAS_MMAP
+      int fd = ::open(path.c_str(), O_RDONLY);
+
+      if (fd == -1)
+        throw std::runtime_error(clon::fmt::format("unable to open file {}", path));
+
+      struct stat st;
+
+      if (::fstat(fd, &st) == -1)
+      {
+        ::close(fd);
+        throw std::runtime_error(clon::fmt::format("unable to stat file {}", path));
+      }
+
+      length = st.st_size;
+
+      if (length != 0)
+      {
+        void *mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (mapped == MAP_FAILED)
+        {
+          ::close(fd);
+          throw std::runtime_error(clon::fmt::format("unable to map file {}", path));
+        }
+
+        addr = static_cast<const char_t *>(mapped);
+        advise(MADV_SEQUENTIAL);
+      }
+
+      ::close(fd);
+#else
+      throw std::runtime_error("memory mapped files are not supported");
+#endif
+    }
+
+    mapped_file(const mapped_file &) = delete;
+
+    mapped_file(mapped_file &&o) noexcept
+        : addr(std::exchange(o.addr, nullptr)),
+          length(std::exchange(o.length, 0)) {}
+
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    mapped_file &operator=(mapped_file &&o) noexcept
+    {
+      std::swap(addr, o.addr);
+      std::swap(length, o.length);
+      return *this;
+    }
+
+    ~mapped_file()
+    {
+#ifdef CLON_HAS_MMAP
+      if (addr != nullptr)
+        ::munmap(const_cast<char_t *>(addr), length);
+#endif
+    }
+
+  public:
+    const char_t *data() const
+    {
+      return addr;
+    }
+
+    std::size_t size() const
+    {
+      return length / sizeof(char_t);
+    }
+
+    void advise([[maybe_unused]] int advice) const
+    {
+#ifdef CLON_HAS_MMAP
+      if (addr != nullptr)
+        ::madvise(const_cast<char_t *>(addr), length, advice);
+#endif
+    }
+  };
+
+  template <typename char_t>
+  using source = std::variant<
+      std::basic_string_view<char_t>,
+      std::basic_string<char_t>,
+      std::vector<char_t>,
+      mapped_file<char_t>>;
+
+  template <typename char_t>
+  std::basic_string_view<char_t> view_of(const source<char_t> &src)
+  {
+    return std::visit(
+        [](const auto &s) {
+          return std::basic_string_view<char_t>(s.data(), s.size());
+        },
+        src);
+  }
+
+  // owns a copy of every distinct name so it can be shared by many
+  // documents and outlive them.
+  template <typename char_t>
+  class name_table
+  {
+    std::deque<std::basic_string<char_t>> names;
+    std::unordered_map<std::basic_string_view<char_t>, std::uint32_t> ids;
+
+  public:
+    std::uint32_t intern(const std::basic_string_view<char_t> &name)
+    {
+      auto found = ids.find(name);
+
+      if (found != ids.end())
+        return found->second;
+
+      const std::uint32_t id = static_cast<std::uint32_t>(names.size());
+      ids.emplace(names.emplace_back(name), id);
+      return id;
+    }
+
+    std::uint32_t find(const std::basic_string_view<char_t> &name) const
+    {
+      auto found = ids.find(name);
+      return found == ids.end() ? no_name : found->second;
+    }
+
+    std::basic_string_view<char_t> name(const std::uint32_t &id) const
+    {
+      return names[id];
+    }
+
+    std::size_t size() const
+    {
+      return names.size();
+    }
+  };
+
+  template <typename char_t>
+  struct parse_options
+  {
+    name_table<char_t> *names = nullptr;
+    bool index_lists = false;
+    bool eager_values = false;
+    std::size_t threads = 1;
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource();
+    std::size_t max_depth = default_max_depth;
+  };
+
+  template <typename char_t>
+  using child_index = std::unordered_map<
+      std::basic_string_view<char_t>,
+      std::vector<std::size_t>>;
+
+  template <typename char_t>
+  using node_list = std::pmr::vector<node<char_t>>;
+
+  // a monotonic arena whose first block comes with it, so that a few small
+  // updates need no other allocation. both come from upstream.
+  struct arena
+  {
+    std::array<std::byte, 768> initial;
+    std::pmr::monotonic_buffer_resource resource;
+
+    explicit arena(std::pmr::memory_resource *upstream)
+        : resource(initial.data(), initial.size(), upstream) {}
+  };
+
+  struct arena_deleter
+  {
+    void operator()(arena *a) const
+    {
+      std::pmr::polymorphic_allocator<arena>(a->resource.upstream_resource()).delete_object(a);
+    }
+  };
+
+  inline std::unique_ptr<arena, arena_deleter> make_arena(
+      std::pmr::memory_resource *upstream)
+  {
+    return std::unique_ptr<arena, arena_deleter>(
+        std::pmr::polymorphic_allocator<arena>(upstream).new_object<arena>(upstream));
+  }
+
+  // updated values live in a monotonic arena, freed at once with the root,
+  // so an update never moves an earlier one. nodes and name ids come from
+  // the same upstream and keep their capacity when the root is reused.
   template <typename char_t>
   struct root_node
   {
-    std::vector<char_t> buff;
-    std::vector<node<char_t>> nodes;
-    std::vector<std::basic_string<char_t>> updt;
+    std::unique_ptr<arena, arena_deleter> memory;
+    source<char_t> buff;
+    node_list<char_t> nodes;
+    std::size_t updated = 0;
+    name_table<char_t> *names = nullptr;
+    std::pmr::vector<std::uint32_t> name_ids;
+    bool index_lists = false;
+    bool eager_values = false;
+    std::size_t threads = 1;
+    std::size_t max_depth = default_max_depth;
+    bool frozen = false;
+    std::unordered_map<std::size_t, child_index<char_t>> indexes;
+
+    explicit root_node(
+        std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : memory(make_arena(upstream)),
+          nodes(upstream), name_ids(upstream) {}
   };
 
+  // copies valv into the arena of root, where it stays until root dies.
   template <typename char_t>
-  root_node<char_t> make_root(
+  std::basic_string_view<char_t> store(
+      root_node<char_t> &root,
+      const std::basic_string_view<char_t> &valv)
+  {
+    char_t *copy = static_cast<char_t *>(
+        root.memory->resource.allocate(valv.size() * sizeof(char_t), alignof(char_t)));
+
+    std::copy(valv.begin(), valv.end(), copy);
+    root.updated += valv.size() * sizeof(char_t);
+    return {copy, valv.size()};
+  }
+
+  // makes root ready to parse data again : nodes and name ids keep their
+  // capacity and the arena falls back to its first block.
+  template <typename char_t>
+  void reset_root(
+      root_node<char_t> &root,
       const std::basic_string_view<char_t> &data)
   {
-    root_node<char_t> root;
-    root.buff = std::vector<char_t>(data.begin(), data.end());
-    root.nodes.reserve(std::count(data.begin(), data.end(), '('));
+    root.buff = data;
+    root.nodes.clear();
+    root.name_ids.clear();
+    root.indexes.clear();
+    root.memory->resource.release();
+    root.updated = 0;
+    root.frozen = false;
+  }
+
+  template <typename char_t>
+  root_node<char_t> make_root(
+      const std::basic_string_view<char_t> &data,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+  {
+    root_node<char_t> root(upstream);
+    root.buff = data;
+    return root;
+  }
+
+  template <typename char_t>
+  root_node<char_t> make_root(
+      std::basic_string<char_t> &&data,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+  {
+    root_node<char_t> root(upstream);
+    root.buff = std::move(data);
+    return root;
+  }
+
+  template <typename char_t>
+  root_node<char_t> make_root(
+      std::vector<char_t> &&data,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+  {
+    root_node<char_t> root(upstream);
+    root.buff = std::move(data);
+    return root;
+  }
+
+  template <typename char_t>
+  root_node<char_t> make_root(
+      mapped_file<char_t> &&data,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+  {
+    root_node<char_t> root(upstream);
+    root.buff = std::move(data);
     return root;
   }
 
@@ -167,14 +572,19 @@ namespace clon::detail
     const std::size_t &child() const { return root->nodes[index].child; }
     const std::size_t &next() const { return root->nodes[index].next; }
     const view &valv() const { return root->nodes[index].valv; }
-    const clon_type type() const { return static_cast<clon_type>(root->nodes[index].val.index()); }
+    const clon_type type() const
+    {
+      return index == no_root
+                 ? clon_type::none
+                 : static_cast<clon_type>(root->nodes[index].val.index());
+    }
 
     template <typename type_t>
     const type_t &as_() const
     {
       if constexpr (std::is_same_v<type_t, boolean>)
         if (type() == clon_type::no_boolean)
-          root->nodes[index].val = root->nodes[index].valv == "true";
+          root->nodes[index].val = to_boolean(root->nodes[index].valv);
 
       if constexpr (std::is_same_v<type_t, string<char_t>>)
         if (type() == clon_type::no_string)
@@ -184,6 +594,10 @@ namespace clon::detail
         if (type() == clon_type::no_number)
           root->nodes[index].val = to_number(root->nodes[index].valv);
 
+      if constexpr (std::is_same_v<type_t, real>)
+        if (type() == clon_type::no_real)
+          root->nodes[index].val = to_real(root->nodes[index].valv);
+
       return std::get<type_t>(root->nodes[index].val);
     }
 
@@ -198,6 +612,8 @@ namespace clon::detail
         return type() == clon_type::string or type() == clon_type::no_string;
       if constexpr (std::is_same_v<type_t, number> or std::is_same_v<type_t, no_number>)
         return type() == clon_type::number or type() == clon_type::no_number;
+      if constexpr (std::is_same_v<type_t, real> or std::is_same_v<type_t, no_real>)
+        return type() == clon_type::real or type() == clon_type::no_real;
       if constexpr (std::is_same_v<type_t, none>)
         return type() == clon_type::none;
     }
@@ -219,10 +635,10 @@ namespace clon::detail
     return make_rview(*view.root, index);
   }
 
-  template <typename char_t>
+  template <typename view_t>
   struct childs_iterator
   {
-    root_view<char_t> view;
+    view_t view;
 
     childs_iterator &operator++()
     {
@@ -237,7 +653,7 @@ namespace clon::detail
       return tmp;
     }
 
-    root_view<char_t> operator*() const { return make_rview(view, view.index); }
+    view_t operator*() const { return view; }
 
     friend bool operator==(
         const childs_iterator &a,
@@ -255,144 +671,383 @@ namespace clon::detail
     }
   };
 
-  template <typename char_t>
+  template <typename view_t>
   struct childs_list
   {
-    root_view<char_t> view;
-    childs_iterator<char_t> begin() const { return {view}; }
-    childs_iterator<char_t> end() const { return {make_rview(view, no_next)}; }
+    view_t view;
+    childs_iterator<view_t> begin() const { return {view}; }
+    childs_iterator<view_t> end() const { return {{view.root, no_next}}; }
   };
 
-  template <typename char_t>
-  childs_list<char_t> childs(const root_view<char_t> &view)
+  template <typename view_t>
+  childs_list<view_t> childs(const view_t &view)
   {
-    return {make_rview(view, view.child())};
+    return {{view.root, view.child()}};
   }
 
   template <typename char_t>
   std::size_t length_of(const root_view<char_t> &view)
   {
-    return view.root->buff.size();
+    return view_of(view.root->buff).size();
   }
 
-  template <typename char_t>
-  void format_of(
+  // one node, a list only up to its first child.
+  template <typename char_t, typename view_t>
+  void format_node(
       fmt::formatter_context<char_t> &ctx,
-      const root_view<char_t> &view)
+      const view_t &view)
   {
     namespace fmt = clon::fmt;
+    using namespace fmt::literals;
 
     switch (view.type())
     {
     case clon_type::no_boolean:
     case clon_type::no_number:
+    case clon_type::no_real:
     case clon_type::boolean:
     case clon_type::number:
-      fmt::format_into(ctx, "({} {})", view.name(), view.valv());
+    case clon_type::real:
+      fmt::format_into(ctx, "({} {})"_fmt, view.name(), view.valv());
       break;
     case clon_type::no_string:
     case clon_type::string:
-      fmt::format_into(ctx, "({} \"{}\")", view.name(), view.valv());
+      fmt::format_into(ctx, "({} \"{}\")"_fmt, view.name(), view.valv());
       break;
     case clon_type::list:
-      fmt::format_into(ctx, "({} ", view.name());
-      for (auto &&child : childs(view))
-        format_of(ctx, child);
-      fmt::format_into(ctx, ")");
+      fmt::format_into(ctx, "({} "_fmt, view.name());
       break;
     case clon_type::none:
       break;
     }
   }
 
-  enum class symbol_type : int
+  // depth first without recursion : lists holds the lists whose children
+  // are not all visited, the last one being the parent of current. open
+  // sees every node with its depth, close every list once its children
+  // are done.
+  template <typename view_t, typename open_t, typename close_t>
+  void walk(const view_t &view, open_t &&open, close_t &&close)
   {
-    eos,
-    blank,
-    letter_f,
-    letter_t,
-    lower,
-    dquote,
-    digit,
-    lpar,
-    rpar,
-    other
-  };
+    std::vector<view_t> lists;
+    view_t current = view;
 
-  constexpr std::array<symbol_type, 128> ascii_build()
-  {
-    std::array<symbol_type, 128> table;
+    while (true)
+    {
+      open(current, lists.size());
 
-    for (symbol_type &sb : table)
-      sb = symbol_type::other;
+      if (current.type() == clon_type::list and current.child() != no_child)
+      {
+        lists.push_back(current);
+        current.index = current.child();
+        continue;
+      }
 
-    for (char l = 'a'; l <= 'z'; ++l)
-      table[l] = symbol_type::lower;
+      if (current.type() == clon_type::list)
+        close(current, lists.size());
 
-    for (char l = '0'; l <= '9'; ++l)
-      table[l] = symbol_type::digit;
+      while (not lists.empty() and current.next() == no_next)
+      {
+        current = lists.back();
+        lists.pop_back();
+        close(current, lists.size());
+      }
 
-    table['f'] = symbol_type::letter_f;
-    table['t'] = symbol_type::letter_t;
-    table['"'] = symbol_type::dquote;
-    table['('] = symbol_type::lpar;
-    table[')'] = symbol_type::rpar;
-    table[' '] = symbol_type::blank;
-    table['\n'] = symbol_type::blank;
-    table['\r'] = symbol_type::blank;
-    table['\t'] = symbol_type::blank;
-    table['\0'] = symbol_type::eos;
+      if (lists.empty())
+        return;
 
-    return table;
+      current.index = current.next();
+    }
   }
 
-  constexpr std::array<symbol_type, 128> ascii_to_sb = ascii_build();
+  template <typename char_t, typename view_t>
+  void format_view(
+      fmt::formatter_context<char_t> &ctx,
+      const view_t &view)
+  {
+    walk(
+        view,
+        [&ctx](const view_t &v, std::size_t) { format_node(ctx, v); },
+        [&ctx](const view_t &, std::size_t) { ctx.append(')'); });
+  }
+
+  // the clon writer : compact is the text of format_view, except that
+  // empty nodes are kept as (name) so that the text parses back to the
+  // same tree. pretty puts every node below the root on its own line
+  // indented by two spaces per depth. write_length gives the exact length, then write_clon copies
+  // names and values into a buffer of that length without any check.
+  template <typename view_t>
+  std::size_t write_length(
+      const view_t &view,
+      const write_mode &mode)
+  {
+    std::size_t len = 0;
+
+    if (view.index == no_root)
+      return len;
 
+    walk(
+        view,
+        [&len, &mode](const view_t &v, const std::size_t &depth) {
+          len += 1 + v.name().size();
+
+          if (mode == write_mode::pretty and depth != 0)
+            len += 1 + 2 * depth;
+
+          switch (v.type())
+          {
+          case clon_type::list:
+            len += mode == write_mode::compact;
+            break;
+          case clon_type::none:
+            len += 1;
+            break;
+          case clon_type::string:
+          case clon_type::no_string:
+            len += 4 + v.valv().size();
+            break;
+          default:
+            len += 2 + v.valv().size();
+            break;
+          }
+        },
+        [&len](const view_t &, std::size_t) { ++len; });
+
+    return len;
+  }
+
+  // where write_nodes puts chars : buffer_output straight into a buffer
+  // of write_length chars, context_output through a formatter context.
   template <typename char_t>
-  struct scanner
+  struct buffer_output
   {
-    std::basic_string_view<char_t> data;
-    std::size_t index = 0;
-    std::size_t prev = 0;
+    char_t *out;
 
-    symbol_type symbol() const
+    void put(const char_t &c)
     {
-      if (index < data.size())
-        return data[index] > 127
-                   ? symbol_type::other
-                   : ascii_to_sb[data[index]];
-      else
-        return symbol_type::eos;
+      *out++ = c;
     }
 
-    void advance(std::size_t step = 1)
+    void put(const std::basic_string_view<char_t> &text)
     {
-      if (index + step <= data.size())
-        index += step;
+      std::char_traits<char_t>::copy(out, text.data(), text.size());
+      out += text.size();
     }
 
-    std::basic_string_view<char_t> extract()
+    void indent(const std::size_t &n)
     {
-      std::basic_string_view<char_t> tk(&data[prev], index - prev);
-      prev = index;
-      return tk;
+      std::char_traits<char_t>::assign(out, n, ' ');
+      out += n;
     }
+  };
 
-    void ignore()
+  template <typename char_t>
+  struct context_output
+  {
+    fmt::formatter_context<char_t> &ctx;
+
+    void put(const char_t &c)
     {
-      prev = index;
+      ctx.append(c);
     }
 
-    bool starts_with(const std::basic_string_view<char_t> &sv) const
+    void put(const std::basic_string_view<char_t> &text)
     {
-      return data.substr(index).starts_with(sv);
+      ctx.append(text.data(), text.size());
     }
 
-    void backward()
+    void indent(std::size_t n)
     {
-      index = index - 1;
-    }
-  };
+      constexpr std::array<char_t, 32> spaces = [] {
+        std::array<char_t, 32> res;
+        res.fill(' ');
+        return res;
+      }();
+
+      while (n != 0)
+      {
+        const std::size_t len = std::min(n, spaces.size());
+        ctx.append(spaces.data(), len);
+        n -= len;
+      }
+    }
+  };
+
+  template <typename output_t, typename view_t>
+  void write_nodes(
+      output_t &out,
+      const view_t &view,
+      const write_mode &mode)
+  {
+    if (view.index == no_root)
+      return;
+
+    walk(
+        view,
+        [&out, &mode](const view_t &v, const std::size_t &depth) {
+          if (mode == write_mode::pretty and depth != 0)
+          {
+            out.put('\n');
+            out.indent(2 * depth);
+          }
+
+          out.put('(');
+          out.put(v.name());
+
+          switch (v.type())
+          {
+          case clon_type::list:
+            if (mode == write_mode::compact)
+              out.put(' ');
+            break;
+          case clon_type::none:
+            out.put(')');
+            break;
+          case clon_type::string:
+          case clon_type::no_string:
+            out.put(' ');
+            out.put('"');
+            out.put(v.valv());
+            out.put('"');
+            out.put(')');
+            break;
+          default:
+            out.put(' ');
+            out.put(v.valv());
+            out.put(')');
+            break;
+          }
+        },
+        [&out](const view_t &, std::size_t) { out.put(')'); });
+  }
+
+  template <typename char_t, typename view_t>
+  char_t *write_clon(
+      char_t *out,
+      const view_t &view,
+      const write_mode &mode)
+  {
+    buffer_output<char_t> output{out};
+    write_nodes(output, view, mode);
+    return output.out;
+  }
+
+  template <typename char_t, typename view_t>
+  void write_clon(
+      fmt::formatter_context<char_t> &ctx,
+      const view_t &view,
+      const write_mode &mode)
+  {
+    context_output<char_t> output{ctx};
+    write_nodes(output, view, mode);
+  }
+
+  template <typename char_t, typename view_t>
+  std::basic_string<char_t> write_clon(
+      const view_t &view,
+      const write_mode &mode)
+  {
+    std::basic_string<char_t> text(write_length(view, mode), char_t(' '));
+    write_clon(text.data(), view, mode);
+    return text;
+  }
+
+  template <typename char_t>
+  void format_of(
+      fmt::formatter_context<char_t> &ctx,
+      const root_view<char_t> &view)
+  {
+    format_view(ctx, view);
+  }
+
+  enum class symbol_type : int
+  {
+    eos,
+    blank,
+    letter_f,
+    letter_t,
+    lower,
+    dquote,
+    digit,
+    lpar,
+    rpar,
+    other
+  };
+
+  constexpr std::array<symbol_type, 128> ascii_build()
+  {
+    std::array<symbol_type, 128> table;
+
+    for (symbol_type &sb : table)
+      sb = symbol_type::other;
+
+    for (char l = 'a'; l <= 'z'; ++l)
+      table[l] = symbol_type::lower;
+
+    for (char l = '0'; l <= '9'; ++l)
+      table[l] = symbol_type::digit;
+
+    table['f'] = symbol_type::letter_f;
+    table['t'] = symbol_type::letter_t;
+    table['"'] = symbol_type::dquote;
+    table['('] = symbol_type::lpar;
+    table[')'] = symbol_type::rpar;
+    table[' '] = symbol_type::blank;
+    table['\n'] = symbol_type::blank;
+    table['\r'] = symbol_type::blank;
+    table['\t'] = symbol_type::blank;
+    table['\0'] = symbol_type::eos;
+
+    return table;
+  }
+
+  constexpr std::array<symbol_type, 128> ascii_to_sb = ascii_build();
+
+  template <typename char_t>
+  struct scanner
+  {
+    std::basic_string_view<char_t> data;
+    std::size_t index = 0;
+    std::size_t prev = 0;
+
+    constexpr symbol_type symbol() const
+    {
+      if (index < data.size())
+        return data[index] > 127
+                   ? symbol_type::other
+                   : ascii_to_sb[data[index]];
+      else
+        return symbol_type::eos;
+    }
+
+    constexpr void advance(std::size_t step = 1)
+    {
+      if (index + step <= data.size())
+        index += step;
+    }
+
+    constexpr std::basic_string_view<char_t> extract()
+    {
+      std::basic_string_view<char_t> tk = data.substr(prev, index - prev);
+      prev = index;
+      return tk;
+    }
+
+    constexpr void ignore()
+    {
+      prev = index;
+    }
+
+    constexpr bool starts_with(const std::basic_string_view<char_t> &sv) const
+    {
+      return data.substr(index).starts_with(sv);
+    }
+
+    constexpr void backward()
+    {
+      index = index - 1;
+    }
+  };
 
   template <typename char_t, std::size_t n>
   void handle_error_expecting(const char_t (&s)[n])
@@ -401,7 +1056,7 @@ namespace clon::detail
   }
 
   template <typename char_t>
-  void ignore_blanks(scanner<char_t> &scan)
+  constexpr void ignore_blanks(scanner<char_t> &scan)
   {
     while (scan.symbol() == symbol_type::blank)
       scan.advance();
@@ -410,7 +1065,7 @@ namespace clon::detail
   }
 
   template <typename char_t>
-  std::basic_string_view<char_t> scan_name(
+  constexpr std::basic_string_view<char_t> scan_name(
       scanner<char_t> &scan)
   {
     ignore_blanks(scan);
@@ -434,595 +1089,3922 @@ namespace clon::detail
   }
 
   template <typename char_t>
-  std::basic_string_view<char_t> scan_boolean(
+  constexpr std::basic_string_view<char_t> scan_number(
       scanner<char_t> &scan)
   {
     ignore_blanks(scan);
 
-    if (scan.starts_with("true"))
-      scan.advance(4);
-    else if (scan.starts_with("false"))
-      scan.advance(5);
-    else
-      handle_error_expecting("'true' or 'false'");
+    if (scan.symbol() != symbol_type::digit)
+      handle_error_expecting("[0-9]");
+
+    while (scan.symbol() == symbol_type::digit)
+      scan.advance();
 
     return scan.extract();
   }
 
-  template <typename char_t>
-  std::basic_string_view<char_t> scan_string(
-      scanner<char_t> &scan)
+  struct block_masks
   {
-    ignore_blanks(scan);
-
-    if (scan.symbol() == symbol_type::dquote)
-    {
-      scan.advance();
-      scan.ignore();
-
-      while (scan.symbol() != symbol_type::dquote)
-        scan.advance();
-
-      if (scan.symbol() == symbol_type::dquote)
-        scan.advance();
-      else
-        handle_error_expecting("'\"'");
-    }
-    else
-      handle_error_expecting("'\"'");
-
-    scan.backward();
-    auto &&str = scan.extract();
-    scan.advance();
-    scan.ignore();
-    return str;
-  }
+    std::uint64_t quote = 0;
+    std::uint64_t paren = 0;
+    std::uint64_t open = 0;
+    std::uint64_t blank = 0;
+  };
 
-  template <typename char_t>
-  std::basic_string_view<char_t> scan_number(
-      scanner<char_t> &scan)
+  struct scalar_classifier
   {
-    ignore_blanks(scan);
+    template <typename char_t>
+    block_masks operator()(const char_t *block) const
+    {
+      block_masks m;
 
-    if (scan.symbol() != symbol_type::digit)
-      handle_error_expecting("[0-9]");
+      for (std::size_t i = 0; i < 64; ++i)
+      {
+        const std::uint64_t bit = std::uint64_t(1) << i;
 
-    while (scan.symbol() == symbol_type::digit)
-      scan.advance();
+        switch (block[i])
+        {
+        case '"':
+          m.quote |= bit;
+          break;
+        case '(':
+          m.open |= bit;
+          m.paren |= bit;
+          break;
+        case ')':
+          m.paren |= bit;
+          break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+          m.blank |= bit;
+          break;
+        default:
+          break;
+        }
+      }
 
-    return scan.extract();
-  }
+      return m;
+    }
+  };
 
-  template <typename char_t>
-  std::basic_string_view<char_t> scan_list(
-      scanner<char_t> &)
-  {
-    return {};
-  }
+#ifdef CLON_SIMD_X86
 
-  template <typename char_t>
-  void open_node(scanner<char_t> &scan)
+  struct sse2_classifier
   {
-    ignore_blanks(scan);
+    __attribute__((target("sse2"))) static std::uint64_t
+    eq16(const __m128i (&v)[4], const char c)
+    {
+      const __m128i k = _mm_set1_epi8(c);
+      return std::uint64_t(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v[0], k)))) |
+             std::uint64_t(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v[1], k)))) << 16 |
+             std::uint64_t(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v[2], k)))) << 32 |
+             std::uint64_t(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v[3], k)))) << 48;
+    }
 
-    if (scan.symbol() == symbol_type::lpar)
+    __attribute__((target("sse2"))) block_masks
+    operator()(const char *block) const
     {
-      scan.advance();
-      scan.ignore();
+      const __m128i v[4] = {
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(block)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48))};
+
+      block_masks m;
+      m.quote = eq16(v, '"');
+      m.open = eq16(v, '(');
+      m.paren = m.open | eq16(v, ')');
+      m.blank = eq16(v, ' ') | eq16(v, '\n') | eq16(v, '\t') | eq16(v, '\r');
+      return m;
     }
-    else
-      handle_error_expecting("'('");
-  }
+  };
 
-  template <typename char_t>
-  void close_node(scanner<char_t> &scan)
+  struct avx2_classifier
   {
-    ignore_blanks(scan);
+    __attribute__((target("avx2"))) static std::uint64_t
+    eq32(const __m256i (&v)[2], const char c)
+    {
+      const __m256i k = _mm256_set1_epi8(c);
+      return std::uint64_t(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v[0], k)))) |
+             std::uint64_t(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v[1], k)))) << 32;
+    }
 
-    if (scan.symbol() == symbol_type::rpar)
+    __attribute__((target("avx2"))) block_masks
+    operator()(const char *block) const
     {
-      scan.advance();
-      scan.ignore();
+      const __m256i v[2] = {
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32))};
+
+      block_masks m;
+      m.quote = eq32(v, '"');
+      m.open = eq32(v, '(');
+      m.paren = m.open | eq32(v, ')');
+      m.blank = eq32(v, ' ') | eq32(v, '\n') | eq32(v, '\t') | eq32(v, '\r');
+      return m;
     }
-    else
-      handle_error_expecting("')'");
+  };
+
+#endif
+
+  inline std::uint64_t prefix_xor(std::uint64_t m)
+  {
+    m ^= m << 1;
+    m ^= m << 2;
+    m ^= m << 4;
+    m ^= m << 8;
+    m ^= m << 16;
+    m ^= m << 32;
+    return m;
   }
 
-  template <typename char_t>
-  struct parser_context
+  struct structural_state
   {
-    std::vector<node<char_t>> *nodes;
-    scanner<char_t> scan;
+    std::uint64_t in_string = 0;
+    std::uint64_t prev_token = 0;
   };
 
-  template <typename char_t>
-  void parse_node(parser_context<char_t> &ctx);
-
-  template <typename char_t>
-  void parse_list(parser_context<char_t> &ctx)
+  // one bit per byte of the block : every quote, every paren outside a
+  // string and the first byte of every name, number or boolean token.
+  inline std::uint64_t structurals_of(
+      const block_masks &m,
+      structural_state &st)
   {
-    ignore_blanks(ctx.scan);
-    std::size_t index = ctx.nodes->size();
-    std::size_t count = 0;
+    const std::uint64_t in_string = prefix_xor(m.quote) ^ st.in_string;
+    const std::uint64_t token = ~(m.quote | m.paren | m.blank | in_string);
+    const std::uint64_t starts = token & ~((token << 1) | st.prev_token);
 
-    while (ctx.scan.symbol() == symbol_type::lpar)
-    {
-      if (count > 0)
-        index = ctx.nodes->at(index).next = ctx.nodes->size();
+    st.in_string = std::uint64_t(0) - (in_string >> 63);
+    st.prev_token = token >> 63;
 
-      parse_node(ctx);
-      ignore_blanks(ctx.scan);
-      count++;
-    }
+    return (m.paren & ~in_string) | m.quote | starts;
   }
 
-  template <typename char_t>
-  clon_type predict_clon_type(scanner<char_t> &scan)
+  inline void flatten_bits(
+      std::vector<std::size_t> &index,
+      const std::size_t &base,
+      std::uint64_t bits)
   {
-    switch (scan.symbol())
+    while (bits != 0)
     {
-    case symbol_type::letter_f:
-    case symbol_type::letter_t:
-      return clon_type::boolean;
-    case symbol_type::dquote:
-      return clon_type::string;
-    case symbol_type::digit:
-      return clon_type::number;
-    case symbol_type::lpar:
-      return clon_type::list;
-    default:
-      return clon_type::none;
+      index.push_back(base + std::countr_zero(bits));
+      bits &= bits - 1;
     }
   }
 
-  template <typename char_t>
-  void parse_node(parser_context<char_t> &ctx)
+  template <typename char_t, typename classifier_t>
+  void find_structurals_with(
+      const std::basic_string_view<char_t> &data,
+      std::size_t from,
+      const std::size_t &to,
+      std::uint64_t *out,
+      structural_state &st,
+      const classifier_t &classify)
   {
-    open_node(ctx.scan);
+    for (; from + 64 <= to; from += 64)
+      *out++ = structurals_of(classify(data.data() + from), st);
 
-    std::basic_string_view<char_t> &&name(scan_name(ctx.scan));
-    ignore_blanks(ctx.scan);
-
-    std::basic_string_view<char_t> scanr;
-    clon_type type = predict_clon_type(ctx.scan);
-
-    switch (type)
+    if (from < to)
     {
-    case clon_type::boolean:
-      scanr = scan_boolean(ctx.scan);
-      break;
-    case clon_type::string:
-      scanr = scan_string(ctx.scan);
-      break;
-    case clon_type::number:
-      scanr = scan_number(ctx.scan);
-      break;
-    case clon_type::list:
-      scanr = scan_list(ctx.scan);
-      break;
-    default:
-      break;
+      std::array<char_t, 64> tail;
+      tail.fill(' ');
+      std::copy(data.begin() + from, data.begin() + to, tail.begin());
+      *out = structurals_of(classify(tail.data()), st);
     }
+  }
 
-    ctx.nodes->emplace_back(make_node(type, name, scanr));
+  enum struct simd_level : int
+  {
+    scalar,
+    sse2,
+    avx2
+  };
 
-    if (type == clon_type::list)
-    {
-      ctx.nodes->back().child = ctx.nodes->size();
-      parse_list(ctx);
-    }
+#ifdef CLON_SIMD_X86
 
-    close_node(ctx.scan);
+  __attribute__((target("sse2"), flatten)) inline void find_structurals_sse2(
+      const std::basic_string_view<char> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      std::uint64_t *out,
+      structural_state &st)
+  {
+    find_structurals_with(data, from, to, out, st, sse2_classifier{});
   }
 
-  template <typename char_t>
-  const root_node<char_t> parse(
-      const std::basic_string_view<char_t> &data)
+  __attribute__((target("avx2"), flatten)) inline void find_structurals_avx2(
+      const std::basic_string_view<char> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      std::uint64_t *out,
+      structural_state &st)
   {
-    root_node<char_t> &&root = make_root(data);
-    parser_context<char_t> ctx{&root.nodes, {data}};
-    parse_node(ctx);
-    return root;
+    find_structurals_with(data, from, to, out, st, avx2_classifier{});
   }
 
-  constexpr std::size_t path_max = maxof<std::size_t>;
+#endif
 
-  template <typename char_t>
-  struct path
+  inline simd_level detect_simd_level()
   {
-    std::basic_string_view<char_t> name;
-    std::size_t min = path_max;
-    std::size_t max = path_max;
-  };
+#ifdef CLON_SIMD_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+      return simd_level::avx2;
+    else
+      return simd_level::sse2;
+#else
+    return simd_level::scalar;
+#endif
+  }
+
+  inline const simd_level best_simd_level = detect_simd_level();
 
   template <typename char_t>
-  bool scan_colon(scanner<char_t> &scan)
+  void find_structurals(
+      const std::basic_string_view<char_t> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      std::uint64_t *out,
+      structural_state &st,
+      const simd_level &level = best_simd_level)
   {
-    if (scan.data[scan.index] == ':')
+#ifdef CLON_SIMD_X86
+    if constexpr (std::is_same_v<char_t, char>)
     {
-      scan.advance();
-      scan.ignore();
-      return true;
+      if (level == simd_level::avx2)
+        return find_structurals_avx2(data, from, to, out, st);
+      if (level == simd_level::sse2)
+        return find_structurals_sse2(data, from, to, out, st);
     }
+#endif
 
-    return false;
+    find_structurals_with(data, from, to, out, st, scalar_classifier{});
   }
 
   template <typename char_t>
-  std::pair<std::size_t, std::size_t> scan_interval(scanner<char_t> &scan)
+  void find_structurals(
+      const std::basic_string_view<char_t> &data,
+      std::vector<std::size_t> &index,
+      const simd_level &level = best_simd_level)
   {
-    if (scan.data[scan.index] == '*')
-    {
-      scan.ignore();
-      return {path_max, path_max};
-    }
-    else
-    {
-      std::size_t &&min = to_integer(scan_number(scan));
-      return {min, min};
-    }
+    structural_state st;
+    std::vector<std::uint64_t> bits((data.size() + 63) / 64);
+    find_structurals(data, 0, data.size(), bits.data(), st, level);
+
+    index.clear();
+
+    for (std::size_t i = 0; i < bits.size(); ++i)
+      flatten_bits(index, i * 64, bits[i]);
+
+    index.push_back(data.size());
   }
 
+  constexpr std::size_t structural_blocks = 16;
+
   template <typename char_t>
-  path<char_t> parse_path(const std::basic_string_view<char_t> &view)
+  struct structural_scanner
   {
-    path<char_t> p;
-    scanner<char_t> scan(view);
-    p.name = scan_name(scan);
+    std::basic_string_view<char_t> data;
+    std::array<std::uint64_t, structural_blocks> bits;
+    std::size_t first = 0;
+    std::size_t scanned = 0;
+    structural_state state;
+    std::size_t index = 0;
+    std::size_t prev = 0;
 
-    if (scan_colon(scan))
-      std::tie(p.min, p.max) = scan_interval(scan);
+    char_t current() const
+    {
+      return index < data.size() ? data[index] : char_t('\0');
+    }
+
+    std::basic_string_view<char_t> extract()
+    {
+      std::basic_string_view<char_t> tk(data.data() + prev, index - prev);
+      prev = index;
+      return tk;
+    }
+
+    void ignore()
+    {
+      prev = index;
+    }
+
+    void refill()
+    {
+      const std::size_t to = std::min(scanned + structural_blocks * 64, data.size());
+      find_structurals(data, scanned, to, bits.data(), state);
+      first = scanned;
+      scanned = to;
+    }
+
+    void restart(const std::size_t &anchor)
+    {
+      scanned = anchor - anchor % 64;
+
+      const bool odd = std::count(
+                           data.begin() + scanned,
+                           data.begin() + anchor, '"') %
+                       2;
+
+      state.in_string = odd ? ~std::uint64_t(0) : 0;
+      state.prev_token = 0;
+      refill();
+    }
+
+    __attribute__((noinline)) std::size_t next_structural(
+        std::size_t from,
+        const std::size_t &anchor)
+    {
+      if (anchor < first or from >= scanned)
+        restart(anchor);
+
+      for (;;)
+      {
+        if (from < scanned)
+        {
+          const std::size_t blocks = (scanned - first + 63) / 64;
+          std::size_t block = (from - first) / 64;
+          std::uint64_t m = bits[block] & (~std::uint64_t(0) << (from % 64));
+
+          while (m == 0 and ++block < blocks)
+            m = bits[block];
+
+          if (m != 0)
+            return first + block * 64 + std::countr_zero(m);
+        }
+
+        if (scanned >= data.size())
+          return data.size();
+
+        from = scanned;
+        refill();
+      }
+    }
+  };
+
+  template <typename char_t>
+  bool is_blank(const char_t &c)
+  {
+    return c == ' ' or c == '\n' or c == '\t' or c == '\r';
+  }
+
+  template <typename char_t>
+  bool is_lower(const char_t &c)
+  {
+    return 'a' <= c and c <= 'z';
+  }
+
+  template <typename char_t>
+  bool is_digit(const char_t &c)
+  {
+    return '0' <= c and c <= '9';
+  }
+
+  // length of the number -?[0-9]+(.[0-9]+)?([eE][+-]?[0-9]+)? starting v.
+  template <typename char_t>
+  std::size_t numeric_prefix(const std::basic_string_view<char_t> &v)
+  {
+    std::size_t i = 0;
+
+    auto &&at = [&v](const std::size_t &j) {
+      return j < v.size() ? v[j] : char_t('\0');
+    };
+
+    auto &&digits = [&] {
+      if (not is_digit(at(i)))
+        handle_error_expecting("[0-9]");
+
+      while (is_digit(at(i)))
+        ++i;
+    };
+
+    if (at(i) == '-')
+      ++i;
+
+    digits();
+
+    if (at(i) == '.')
+    {
+      ++i;
+      digits();
+    }
+
+    if (at(i) == 'e' or at(i) == 'E')
+    {
+      ++i;
+
+      if (at(i) == '+' or at(i) == '-')
+        ++i;
+
+      digits();
+    }
+
+    return i;
+  }
+
+  template <typename char_t>
+  void ignore_blanks(structural_scanner<char_t> &scan)
+  {
+    if (is_blank(scan.current()))
+    {
+      ++scan.index;
+
+      if (is_blank(scan.current()))
+        scan.index = scan.next_structural(scan.index, scan.index);
+    }
+
+    scan.ignore();
+  }
+
+  template <typename char_t>
+  std::basic_string_view<char_t> scan_name(
+      structural_scanner<char_t> &scan)
+  {
+    ignore_blanks(scan);
+
+    if (not is_lower(scan.current()))
+      handle_error_expecting("[a-z]");
+
+    while (is_lower(scan.current()))
+      ++scan.index;
+
+    return scan.extract();
+  }
+
+  template <typename char_t>
+  std::basic_string_view<char_t> scan_boolean(
+      structural_scanner<char_t> &scan)
+  {
+    ignore_blanks(scan);
+
+    constexpr char_t no[] = {'f', 'a', 'l', 's', 'e'};
+    std::basic_string_view<char_t> rest = scan.data.substr(scan.index);
+
+    if (to_boolean(rest.substr(0, 4)))
+      scan.index += 4;
+    else if (rest.starts_with(std::basic_string_view<char_t>(no, 5)))
+      scan.index += 5;
     else
-      p.min = p.max = 0;
+      handle_error_expecting("'true' or 'false'");
 
-    return p;
+    return scan.extract();
   }
 
   template <typename char_t>
-  struct splits_iterator
+  std::basic_string_view<char_t> scan_string(
+      structural_scanner<char_t> &scan)
   {
-    char_t del;
-    std::basic_string_view<char_t> data;
+    ignore_blanks(scan);
+
+    if (scan.current() != '"')
+      handle_error_expecting("'\"'");
+
+    const std::size_t closing = scan.next_structural(scan.index + 1, scan.index);
+
+    if (closing >= scan.data.size())
+      handle_error_expecting("'\"'");
+
+    std::basic_string_view<char_t> str(
+        scan.data.data() + scan.index + 1, closing - scan.index - 1);
+    scan.index = closing + 1;
+    scan.ignore();
+    return str;
+  }
+
+  template <typename char_t>
+  std::basic_string_view<char_t> scan_number(
+      structural_scanner<char_t> &scan)
+  {
+    ignore_blanks(scan);
+    scan.index += numeric_prefix(scan.data.substr(scan.index));
+    return scan.extract();
+  }
+
+  template <typename char_t>
+  std::basic_string_view<char_t> scan_list(
+      structural_scanner<char_t> &)
+  {
+    return {};
+  }
+
+  template <typename char_t>
+  void open_node(structural_scanner<char_t> &scan)
+  {
+    ignore_blanks(scan);
+
+    if (scan.current() == '(')
+    {
+      ++scan.index;
+      scan.ignore();
+    }
+    else
+      handle_error_expecting("'('");
+  }
+
+  template <typename char_t>
+  void close_node(structural_scanner<char_t> &scan)
+  {
+    ignore_blanks(scan);
+
+    if (scan.current() == ')')
+    {
+      ++scan.index;
+      scan.ignore();
+    }
+    else
+      handle_error_expecting("')'");
+  }
+
+  struct list_frame
+  {
+    std::size_t node;
+    std::size_t last = no_next;
+  };
+
+  template <typename visitor_t, typename char_t>
+  concept clon_visitor =
+      requires(visitor_t &v, const std::basic_string_view<char_t> &s) {
+        v.on_open(s);
+        v.on_boolean(s);
+        v.on_number(s);
+        v.on_string(s);
+        v.on_close();
+      };
+
+  template <typename char_t, typename visitor_t>
+  struct parser_context
+  {
+    visitor_t *visitor;
+    structural_scanner<char_t> scan;
+    std::size_t max_depth = default_max_depth;
+  };
+
+  template <typename char_t>
+  clon_type predict_clon_type(structural_scanner<char_t> &scan)
+  {
+    switch (scan.current())
+    {
+    case 'f':
+    case 't':
+      return clon_type::boolean;
+    case '"':
+      return clon_type::string;
+    case '(':
+      return clon_type::list;
+    default:
+      return is_digit(scan.current()) or scan.current() == '-'
+                 ? clon_type::number
+                 : clon_type::none;
+    }
+  }
+
+  // one node and all of its descendants, without recursion : depth counts
+  // the lists still open, base of them being open before the node. a list
+  // always starts with a child, after a node closes either a sibling
+  // follows or its parent closes.
+  template <typename char_t, typename visitor_t>
+  void parse_node(
+      parser_context<char_t, visitor_t> &ctx,
+      const std::size_t &base = 0)
+  {
+    std::size_t depth = base;
+
+    do
+    {
+      if (depth >= ctx.max_depth)
+        handle_too_deep();
+
+      open_node(ctx.scan);
+      ctx.visitor->on_open(scan_name(ctx.scan));
+      ignore_blanks(ctx.scan);
+
+      switch (predict_clon_type(ctx.scan))
+      {
+      case clon_type::boolean:
+        ctx.visitor->on_boolean(scan_boolean(ctx.scan));
+        break;
+      case clon_type::string:
+        ctx.visitor->on_string(scan_string(ctx.scan));
+        break;
+      case clon_type::number:
+        ctx.visitor->on_number(scan_number(ctx.scan));
+        break;
+      case clon_type::list:
+        ++depth;
+        continue;
+      default:
+        break;
+      }
+
+      close_node(ctx.scan);
+      ctx.visitor->on_close();
+
+      while (depth > base)
+      {
+        ignore_blanks(ctx.scan);
+
+        if (ctx.scan.current() == '(')
+          break;
+
+        close_node(ctx.scan);
+        ctx.visitor->on_close();
+        --depth;
+      }
+    } while (depth > base);
+  }
+
+  // siblings, each with its descendants, as long as a '(' comes.
+  template <typename char_t, typename visitor_t>
+  void parse_list(
+      parser_context<char_t, visitor_t> &ctx,
+      const std::size_t &base)
+  {
+    ignore_blanks(ctx.scan);
+
+    while (ctx.scan.current() == '(')
+    {
+      parse_node(ctx, base);
+      ignore_blanks(ctx.scan);
+    }
+  }
+
+  template <typename char_t, typename visitor_t>
+  requires clon_visitor<visitor_t, char_t>
+  void parse_events(
+      const std::basic_string_view<char_t> &data,
+      visitor_t &visitor,
+      const std::size_t &max_depth = default_max_depth)
+  {
+    parser_context<char_t, visitor_t> ctx{&visitor, {data}, max_depth};
+    parse_node(ctx);
+  }
+
+  // while a node is open its next field holds its parent, it is reset
+  // once the node closes and only then can a sibling be linked to it.
+  template <typename char_t, typename nodes_t = node_list<char_t>>
+  class tree_builder
+  {
+    nodes_t &nodes;
+    name_table<char_t> *names;
+    std::pmr::vector<std::uint32_t> &name_ids;
+    bool eager;
+    std::size_t open = no_root;
+    std::size_t last = no_next;
+
+  public:
+    explicit tree_builder(root_node<char_t> &root)
+        : nodes(root.nodes), names(root.names), name_ids(root.name_ids),
+          eager(root.eager_values) {}
+
+    // builds into a part of root.nodes, names are interned afterwards.
+    tree_builder(nodes_t &_nodes, root_node<char_t> &root)
+        : nodes(_nodes), names(nullptr), name_ids(root.name_ids),
+          eager(root.eager_values) {}
+
+  public:
+    void on_open(const std::basic_string_view<char_t> &name)
+    {
+      const std::size_t index = nodes.size();
+
+      if (last != no_next)
+        nodes[last].next = index;
+      else if (open != no_root)
+      {
+        nodes[open].val = list{};
+        nodes[open].child = index;
+      }
+
+      node<char_t> &n = nodes.emplace_back(make_node<char_t>(clon_type::none, name, {}));
+      n.next = open;
+
+      if (names != nullptr)
+        name_ids.push_back(names->intern(name));
+
+      open = index;
+      last = no_next;
+    }
+
+    void on_boolean(const std::basic_string_view<char_t> &valv)
+    {
+      if (eager)
+        nodes.back().val = to_boolean(valv);
+      else
+        nodes.back().val = no_boolean{};
+
+      nodes.back().valv = valv;
+    }
+
+    void on_number(const std::basic_string_view<char_t> &valv)
+    {
+      if (is_real(valv))
+      {
+        if (eager)
+          nodes.back().val = to_real(valv);
+        else
+          nodes.back().val = no_real{};
+      }
+      else if (eager)
+        nodes.back().val = to_number(valv);
+      else
+        nodes.back().val = no_number{};
+
+      nodes.back().valv = valv;
+    }
+
+    void on_string(const std::basic_string_view<char_t> &valv)
+    {
+      nodes.back().val = no_string{};
+      nodes.back().valv = valv;
+    }
+
+    void on_close()
+    {
+      last = open;
+      open = nodes[last].next;
+      nodes[last].next = no_next;
+    }
+  };
+
+  // runs func(0) .. func(threads - 1), func(0) on the calling thread.
+  template <typename func_t>
+  void run_parallel(const std::size_t &threads, func_t &&func)
+  {
+    std::vector<std::thread> pool;
+
+    for (std::size_t t = 1; t < threads; ++t)
+      pool.emplace_back([&func, t] { func(t); });
+
+    func(std::size_t(0));
+
+    for (std::thread &worker : pool)
+      worker.join();
+  }
+
+  constexpr std::size_t parallel_threshold = 1 << 20;
+  constexpr std::size_t no_split = maxof<std::size_t>;
+
+  // what a chunk does to the paren depth counted outside strings, for
+  // both string states it may start in : delta[0] outside, delta[1] inside.
+  struct chunk_summary
+  {
+    bool odd = false;
+    std::ptrdiff_t delta[2] = {0, 0};
+    bool in_string = false;
+    std::ptrdiff_t depth = 0;
+    std::size_t opens[2] = {0, 0};
+    std::size_t split = no_split;
+  };
+
+  // nodes [first, last) of a vector sized up front, filled like a vector
+  // but indexed like the whole of it.
+  template <typename char_t>
+  struct node_window
+  {
+    node_list<char_t> &nodes;
+    std::size_t first;
+    std::size_t last;
+    std::size_t filled = first;
+
+    std::size_t size() const
+    {
+      return filled;
+    }
+
+    node<char_t> &operator[](const std::size_t &i)
+    {
+      return nodes[i];
+    }
+
+    node<char_t> &back()
+    {
+      return nodes[filled - 1];
+    }
+
+    node<char_t> &emplace_back(node<char_t> &&n)
+    {
+      if (filled == last)
+        handle_error_expecting("')'");
+
+      return nodes[filled++] = std::move(n);
+    }
+  };
+
+  // counts one block into the chunk, carry being the string state the
+  // block starts in when the chunk starts outside a string.
+  inline void summarize_block(
+      const block_masks &m,
+      std::uint64_t &carry,
+      chunk_summary &chunk)
+  {
+    const std::uint64_t in_string = prefix_xor(m.quote) ^ carry;
+    const std::uint64_t close = m.paren & ~m.open;
+
+    const std::size_t opens[2] = {
+        std::size_t(std::popcount(m.open & ~in_string)),
+        std::size_t(std::popcount(m.open & in_string))};
+
+    chunk.opens[0] += opens[0];
+    chunk.opens[1] += opens[1];
+    chunk.delta[0] += std::ptrdiff_t(opens[0]) - std::popcount(close & ~in_string);
+    chunk.delta[1] += std::ptrdiff_t(opens[1]) - std::popcount(close & in_string);
+    carry = std::uint64_t(0) - (in_string >> 63);
+  }
+
+  template <typename char_t, typename classifier_t>
+  void summarize_chunk_with(
+      const std::basic_string_view<char_t> &data,
+      std::size_t from,
+      const std::size_t &to,
+      chunk_summary &chunk,
+      const classifier_t &classify)
+  {
+    std::uint64_t carry = 0;
+
+    for (; from + 64 <= to; from += 64)
+      summarize_block(classify(data.data() + from), carry, chunk);
+
+    if (from < to)
+    {
+      std::array<char_t, 64> tail;
+      tail.fill(' ');
+      std::copy(data.begin() + from, data.begin() + to, tail.begin());
+      summarize_block(classify(tail.data()), carry, chunk);
+    }
+
+    chunk.odd = carry != 0;
+  }
+
+  // first '(' opening a child of the root, once the chunk knows the string
+  // state and the depth it starts with.
+  template <typename char_t>
+  bool find_split_in(
+      const std::basic_string_view<char_t> &data,
+      const std::size_t &base,
+      std::uint64_t parens,
+      std::ptrdiff_t &depth,
+      chunk_summary &chunk)
+  {
+    for (; parens != 0; parens &= parens - 1)
+    {
+      const std::size_t pos = base + std::countr_zero(parens);
+
+      if (data[pos] == ')')
+        --depth;
+      else if (depth++ == 1)
+      {
+        chunk.split = pos;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  template <typename char_t, typename classifier_t>
+  void find_split_with(
+      const std::basic_string_view<char_t> &data,
+      std::size_t from,
+      const std::size_t &to,
+      chunk_summary &chunk,
+      const classifier_t &classify)
+  {
+    std::uint64_t carry = chunk.in_string ? ~std::uint64_t(0) : 0;
+    std::ptrdiff_t depth = chunk.depth;
+
+    for (; from < to; from += 64)
+    {
+      block_masks m;
+
+      if (from + 64 <= to)
+        m = classify(data.data() + from);
+      else
+      {
+        std::array<char_t, 64> tail;
+        tail.fill(' ');
+        std::copy(data.begin() + from, data.begin() + to, tail.begin());
+        m = classify(tail.data());
+      }
+
+      const std::uint64_t in_string = prefix_xor(m.quote) ^ carry;
+      carry = std::uint64_t(0) - (in_string >> 63);
+
+      if (find_split_in(data, from, m.paren & ~in_string, depth, chunk))
+        return;
+    }
+  }
+
+#ifdef CLON_SIMD_X86
+
+  __attribute__((target("sse2"), flatten)) inline void summarize_chunk_sse2(
+      const std::basic_string_view<char> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      chunk_summary &chunk)
+  {
+    summarize_chunk_with(data, from, to, chunk, sse2_classifier{});
+  }
+
+  __attribute__((target("sse2"), flatten)) inline void find_split_sse2(
+      const std::basic_string_view<char> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      chunk_summary &chunk)
+  {
+    find_split_with(data, from, to, chunk, sse2_classifier{});
+  }
+
+  __attribute__((target("avx2"), flatten)) inline void summarize_chunk_avx2(
+      const std::basic_string_view<char> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      chunk_summary &chunk)
+  {
+    summarize_chunk_with(data, from, to, chunk, avx2_classifier{});
+  }
+
+  __attribute__((target("avx2"), flatten)) inline void find_split_avx2(
+      const std::basic_string_view<char> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      chunk_summary &chunk)
+  {
+    find_split_with(data, from, to, chunk, avx2_classifier{});
+  }
+
+#endif
+
+  template <typename char_t>
+  void summarize_chunk(
+      const std::basic_string_view<char_t> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      chunk_summary &chunk)
+  {
+#ifdef CLON_SIMD_X86
+    if constexpr (std::is_same_v<char_t, char>)
+    {
+      if (best_simd_level == simd_level::avx2)
+        return summarize_chunk_avx2(data, from, to, chunk);
+      if (best_simd_level == simd_level::sse2)
+        return summarize_chunk_sse2(data, from, to, chunk);
+    }
+#endif
+
+    summarize_chunk_with(data, from, to, chunk, scalar_classifier{});
+  }
+
+  template <typename char_t>
+  void find_split(
+      const std::basic_string_view<char_t> &data,
+      const std::size_t &from,
+      const std::size_t &to,
+      chunk_summary &chunk)
+  {
+#ifdef CLON_SIMD_X86
+    if constexpr (std::is_same_v<char_t, char>)
+    {
+      if (best_simd_level == simd_level::avx2)
+        return find_split_avx2(data, from, to, chunk);
+      if (best_simd_level == simd_level::sse2)
+        return find_split_sse2(data, from, to, chunk);
+    }
+#endif
+
+    find_split_with(data, from, to, chunk, scalar_classifier{});
+  }
+
+  // parses a run of root children into its window of root.nodes.
+  template <typename char_t>
+  bool parse_siblings(
+      root_node<char_t> &root,
+      node_window<char_t> &window,
+      const std::basic_string_view<char_t> &run,
+      const bool &last)
+  {
+    try
+    {
+      tree_builder<char_t, node_window<char_t>> builder(window, root);
+      parser_context<char_t, tree_builder<char_t, node_window<char_t>>> ctx{&builder, {run}, root.max_depth};
+      parse_list(ctx, 1);
+
+      return window.filled == window.last and
+             (last ? ctx.scan.current() == ')' : ctx.scan.index == run.size());
+    }
+    catch (...)
+    {
+      return false;
+    }
+  }
+
+  // interns the names of nodes already built, from one thread only
+  // since name_table is not synchronized.
+  template <typename char_t>
+  void intern_names(root_node<char_t> &root)
+  {
+    root.name_ids.clear();
+    root.name_ids.reserve(root.nodes.size());
+
+    for (const node<char_t> &n : root.nodes)
+      root.name_ids.push_back(root.names->intern(n.name));
+  }
+
+  // two phases : chunks first resolve their string state and paren depth
+  // by prefix sum, which splits the root children into runs, then each run
+  // is built in its own part of root.nodes and the runs are linked. returns
+  // false when the document does not split or does not parse, the serial
+  // parser then gives the result or the error.
+  template <typename char_t>
+  bool parse_parallel(
+      root_node<char_t> &root,
+      const std::basic_string_view<char_t> &data)
+  {
+    const std::size_t threads = std::max<std::size_t>(root.threads, 1);
+    const std::size_t size = ((data.size() + threads * 64 - 1) / (threads * 64)) * 64;
+    std::vector<chunk_summary> chunks(threads);
+
+    auto &&from = [&](const std::size_t &t) { return std::min(t * size, data.size()); };
+    auto &&to = [&](const std::size_t &t) { return std::min(t * size + size, data.size()); };
+
+    run_parallel(threads, [&](const std::size_t &t) {
+      summarize_chunk(data, from(t), to(t), chunks[t]);
+    });
+
+    bool in_string = false;
+    std::ptrdiff_t depth = 0;
+
+    for (chunk_summary &chunk : chunks)
+    {
+      chunk.in_string = in_string;
+      chunk.depth = depth;
+      depth += chunk.delta[in_string];
+      in_string ^= chunk.odd;
+    }
+
+    run_parallel(threads, [&](const std::size_t &t) {
+      find_split(data, from(t), to(t), chunks[t]);
+    });
+
+    std::vector<std::size_t> splits;
+
+    for (const chunk_summary &chunk : chunks)
+      if (chunk.split != no_split)
+        splits.push_back(chunk.split);
+
+    if (splits.empty())
+      return false;
+
+    structural_scanner<char_t> scan{data};
+    std::basic_string_view<char_t> name;
+
+    try
+    {
+      open_node(scan);
+      name = scan_name(scan);
+      ignore_blanks(scan);
+    }
+    catch (...)
+    {
+      return false;
+    }
+
+    if (scan.current() != '(' or scan.index != splits.front())
+      return false;
+
+    splits.push_back(data.size());
+
+    const std::size_t runs = splits.size() - 1;
+    std::vector<chunk_summary> counts(runs);
+
+    run_parallel(runs, [&](const std::size_t &t) {
+      summarize_chunk(data, splits[t], splits[t + 1], counts[t]);
+    });
+
+    std::vector<node_window<char_t>> windows;
+    std::size_t total = 1;
+
+    for (const chunk_summary &count : counts)
+    {
+      windows.push_back({root.nodes, total, total + count.opens[0]});
+      total += count.opens[0];
+    }
+
+    root.nodes.resize(total);
+    root.nodes[0] = make_node<char_t>(clon_type::list, name, {});
+    root.nodes[0].child = 1;
+
+    std::vector<char> parsed(runs);
+
+    run_parallel(runs, [&](const std::size_t &t) {
+      const std::basic_string_view<char_t> run = data.substr(splits[t], splits[t + 1] - splits[t]);
+      parsed[t] = parse_siblings(root, windows[t], run, t + 1 == runs);
+
+      if (parsed[t] and t + 1 < runs)
+      {
+        std::size_t last = windows[t].first;
+
+        while (root.nodes[last].next != no_next)
+          last = root.nodes[last].next;
+
+        root.nodes[last].next = windows[t + 1].first;
+      }
+    });
+
+    if (std::count(parsed.begin(), parsed.end(), false) != 0)
+    {
+      root.nodes.clear();
+      return false;
+    }
+
+    if (root.names != nullptr)
+      intern_names(root);
+
+    return true;
+  }
+
+  template <typename char_t>
+  void parse(root_node<char_t> &root)
+  {
+    const std::basic_string_view<char_t> data = view_of(root.buff);
+    root.nodes.clear();
+    root.name_ids.clear();
+
+    if (root.threads < 2 or data.size() < parallel_threshold or
+        not parse_parallel(root, data))
+    {
+      // a reused root keeps its capacity and only grows past it.
+      if (root.nodes.capacity() == 0)
+        root.nodes.reserve(std::count(data.begin(), data.end(), '('));
+
+      if (root.names != nullptr and root.name_ids.capacity() < root.nodes.capacity())
+        root.name_ids.reserve(root.nodes.capacity());
+
+      tree_builder<char_t> builder(root);
+      parse_events(data, builder, root.max_depth);
+    }
+
+#ifdef CLON_HAS_MMAP
+    if (auto *mapped = std::get_if<mapped_file<char_t>>(&root.buff))
+      mapped->advise(MADV_NORMAL);
+#endif
+  }
+
+  template <typename char_t>
+  const root_node<char_t> parse(
+      const std::basic_string_view<char_t> &data)
+  {
+    root_node<char_t> root = make_root(data);
+    parse(root);
+    return root;
+  }
+
+  // every top level document of data, found from the structural bitmap
+  // by counting parens outside strings.
+  template <typename char_t>
+  std::vector<std::basic_string_view<char_t>> split_documents(
+      const std::basic_string_view<char_t> &data)
+  {
+    structural_state st;
+    std::vector<std::uint64_t> bits((data.size() + 63) / 64);
+    find_structurals(data, 0, data.size(), bits.data(), st, best_simd_level);
+
+    std::vector<std::basic_string_view<char_t>> docs;
+    std::size_t depth = 0;
+    std::size_t start = 0;
+    bool in_string = false;
+
+    for (std::size_t i = 0; i < bits.size(); ++i)
+      for (std::uint64_t word = bits[i]; word != 0; word &= word - 1)
+      {
+        const std::size_t pos = i * 64 + std::countr_zero(word);
+        const char_t c = data[pos];
+
+        if (c == '"' and depth != 0)
+          in_string = not in_string;
+        else if (in_string)
+          continue;
+        else if (c == '(')
+        {
+          if (depth++ == 0)
+            start = pos;
+        }
+        else if (c == ')' and depth != 0)
+        {
+          if (--depth == 0)
+            docs.push_back(data.substr(start, pos + 1 - start));
+        }
+        else if (depth == 0)
+          handle_error_expecting("'('");
+      }
+
+    if (depth != 0)
+      docs.push_back(data.substr(start));
+
+    return docs;
+  }
+
+  template <typename char_t>
+  void configure(
+      root_node<char_t> &root,
+      const parse_options<char_t> &opts)
+  {
+    root.names = opts.names;
+    root.index_lists = opts.index_lists;
+    root.eager_values = opts.eager_values;
+    root.threads = opts.threads;
+    root.max_depth = opts.max_depth;
+  }
+
+  template <typename char_t>
+  std::unique_ptr<root_node<char_t>> parse_root(
+      root_node<char_t> &&root,
+      const parse_options<char_t> &opts = {})
+  {
+    auto parsed = std::make_unique<root_node<char_t>>(std::move(root));
+    configure(*parsed, opts);
+    parse(*parsed);
+    return parsed;
+  }
+
+  enum struct stream_state : int
+  {
+    open,
+    name_start,
+    name,
+    value_start,
+    string,
+    number,
+    boolean,
+    close,
+    list,
+    done
+  };
+
+  struct token_span
+  {
+    std::size_t offset = 0;
+    std::size_t length = 0;
+  };
+
+  struct node_spans
+  {
+    token_span name;
+    token_span valv;
+  };
+
+  template <typename char_t>
+  class stream_parser
+  {
+    std::basic_string<char_t> text;
+    std::vector<node<char_t>> nodes;
+    std::vector<node_spans> spans;
+    std::vector<list_frame> frames;
+    stream_state state = stream_state::open;
+    token_span name;
+    token_span valv;
+
+  public:
+    void feed(const std::basic_string_view<char_t> &chunk)
+    {
+      std::size_t i = 0;
+
+      while (i < chunk.size())
+      {
+        const char_t c = chunk[i];
+
+        switch (state)
+        {
+        case stream_state::open:
+          if (is_blank(c))
+            ++i;
+          else if (c == '(')
+          {
+            ++i;
+            state = stream_state::name_start;
+          }
+          else
+            handle_error_expecting("'('");
+          break;
+
+        case stream_state::name_start:
+          if (is_blank(c))
+            ++i;
+          else if (is_lower(c))
+          {
+            name = {text.size(), 0};
+            state = stream_state::name;
+          }
+          else
+            handle_error_expecting("[a-z]");
+          break;
+
+        case stream_state::name:
+          i = append_while(chunk, i, is_lower<char_t>);
+
+          if (i < chunk.size())
+          {
+            name.length = text.size() - name.offset;
+            state = stream_state::value_start;
+          }
+          break;
+
+        case stream_state::value_start:
+          valv = {text.size(), 0};
+
+          if (is_blank(c))
+            ++i;
+          else if (c == '"')
+          {
+            ++i;
+            state = stream_state::string;
+          }
+          else if (is_digit(c) or c == '-')
+            state = stream_state::number;
+          else if (c == 't' or c == 'f')
+            state = stream_state::boolean;
+          else if (c == '(')
+          {
+            emit(clon_type::list);
+            state = stream_state::open;
+          }
+          else
+          {
+            emit(clon_type::none);
+            state = stream_state::close;
+          }
+          break;
+
+        case stream_state::string:
+        {
+          const std::size_t found = chunk.find('"', i);
+          const std::size_t end = found == chunk.npos ? chunk.size() : found;
+          text.append(chunk.data() + i, end - i);
+          i = end;
+
+          if (found != chunk.npos)
+          {
+            ++i;
+            emit(clon_type::string);
+            state = stream_state::close;
+          }
+        }
+        break;
+
+        case stream_state::number:
+          i = append_while(chunk, i, is_numeric);
+
+          if (i < chunk.size())
+          {
+            scan_number();
+            state = stream_state::close;
+          }
+          break;
+
+        case stream_state::boolean:
+          text.push_back(c);
+          ++i;
+          scan_boolean();
+          break;
+
+        case stream_state::close:
+          if (is_blank(c))
+            ++i;
+          else if (c == ')')
+          {
+            ++i;
+            close();
+          }
+          else
+            handle_error_expecting("')'");
+          break;
+
+        case stream_state::list:
+          if (is_blank(c))
+            ++i;
+          else if (c == '(')
+          {
+            ++i;
+            state = stream_state::name_start;
+          }
+          else if (c == ')')
+          {
+            ++i;
+            frames.pop_back();
+            close();
+          }
+          else
+            handle_error_expecting("')'");
+          break;
+
+        case stream_state::done:
+          i = chunk.size();
+          break;
+        }
+      }
+    }
+
+    void finish(root_node<char_t> &root)
+    {
+      switch (state)
+      {
+      case stream_state::open:
+        handle_error_expecting("'('");
+        break;
+      case stream_state::name_start:
+        handle_error_expecting("[a-z]");
+        break;
+      case stream_state::string:
+        handle_error_expecting("'\"'");
+        break;
+      case stream_state::boolean:
+        handle_error_expecting("'true' or 'false'");
+        break;
+      case stream_state::number:
+        scan_number();
+        handle_error_expecting("')'");
+        break;
+      case stream_state::done:
+        break;
+      default:
+        handle_error_expecting("')'");
+        break;
+      }
+
+      root.buff = std::move(text);
+      root.nodes.assign(
+          std::make_move_iterator(nodes.begin()),
+          std::make_move_iterator(nodes.end()));
+      root.updated = 0;
+
+      const std::basic_string_view<char_t> data = view_of(root.buff);
+
+      for (std::size_t i = 0; i < root.nodes.size(); ++i)
+      {
+        root.nodes[i].name = data.substr(spans[i].name.offset, spans[i].name.length);
+
+        if (spans[i].valv.length != 0)
+          root.nodes[i].valv = data.substr(spans[i].valv.offset, spans[i].valv.length);
+      }
+
+      reset();
+    }
+
+    void reset()
+    {
+      text = {};
+      nodes = {};
+      spans.clear();
+      frames.clear();
+      state = stream_state::open;
+    }
+
+  private:
+    template <typename pred_t>
+    std::size_t append_while(
+        const std::basic_string_view<char_t> &chunk,
+        std::size_t i,
+        pred_t &&pred)
+    {
+      const std::size_t from = i;
+
+      while (i < chunk.size() and pred(chunk[i]))
+        ++i;
+
+      text.append(chunk.data() + from, i - from);
+      return i;
+    }
+
+    static bool is_numeric(const char_t &c)
+    {
+      return is_digit(c) or c == '-' or c == '+' or
+             c == '.' or c == 'e' or c == 'E';
+    }
+
+    void scan_number()
+    {
+      const std::basic_string_view<char_t> tk(
+          text.data() + valv.offset, text.size() - valv.offset);
+
+      if (numeric_prefix(tk) != tk.size())
+        handle_error_expecting("')'");
+
+      emit(is_real(tk) ? clon_type::real : clon_type::number);
+    }
+
+    void scan_boolean()
+    {
+      constexpr std::basic_string_view<char> t = "true";
+      constexpr std::basic_string_view<char> f = "false";
+      const std::size_t len = text.size() - valv.offset;
+      const std::basic_string_view<char_t> tk(text.data() + valv.offset, len);
+
+      const bool maybe_true = len <= t.size() and std::equal(tk.begin(), tk.end(), t.begin());
+      const bool maybe_false = len <= f.size() and std::equal(tk.begin(), tk.end(), f.begin());
+
+      if (not maybe_true and not maybe_false)
+        handle_error_expecting("'true' or 'false'");
+
+      if ((maybe_true and len == t.size()) or
+          (maybe_false and len == f.size()))
+      {
+        emit(clon_type::boolean);
+        state = stream_state::close;
+      }
+    }
+
+    void emit(const clon_type &type)
+    {
+      const std::size_t index = nodes.size();
+
+      if (not frames.empty())
+      {
+        list_frame &parent = frames.back();
+
+        if (parent.last == no_next)
+          nodes[parent.node].child = index;
+        else
+          nodes[parent.last].next = index;
+
+        parent.last = index;
+      }
+
+      valv.length = text.size() - valv.offset;
+      nodes.emplace_back(make_node<char_t>(type, {}, {}));
+      spans.push_back({name, valv});
+
+      if (type == clon_type::list)
+        frames.push_back({index});
+    }
+
+    void close()
+    {
+      state = frames.empty()
+                  ? stream_state::done
+                  : stream_state::list;
+    }
+  };
+
+  constexpr std::size_t path_max = maxof<std::size_t>;
+
+  template <typename char_t>
+  struct path
+  {
+    std::basic_string_view<char_t> name;
+    std::size_t min = path_max;
+    std::size_t max = path_max;
+    std::uint32_t id = no_name;
+  };
+
+  template <typename char_t>
+  constexpr bool scan_colon(scanner<char_t> &scan)
+  {
+    if (scan.index < scan.data.size() and scan.data[scan.index] == ':')
+    {
+      scan.advance();
+      scan.ignore();
+      return true;
+    }
+
+    return false;
+  }
+
+  template <typename char_t>
+  constexpr std::pair<std::size_t, std::size_t> scan_interval(scanner<char_t> &scan)
+  {
+    if (scan.index < scan.data.size() and scan.data[scan.index] == '*')
+    {
+      scan.advance();
+      scan.ignore();
+      return {0, path_max};
+    }
+
+    std::size_t &&min = to_integer(scan_number(scan));
+
+    if (scan.index < scan.data.size() and scan.data[scan.index] == '-')
+    {
+      scan.advance();
+      scan.ignore();
+      return {min, to_integer(scan_number(scan))};
+    }
+
+    return {min, min};
+  }
+
+  template <typename char_t>
+  constexpr path<char_t> parse_path(const std::basic_string_view<char_t> &view)
+  {
+    path<char_t> p;
+    scanner<char_t> scan(view);
+    p.name = scan_name(scan);
+
+    if (scan_colon(scan))
+      std::tie(p.min, p.max) = scan_interval(scan);
+    else
+      p.min = p.max = 0;
+
+    return p;
+  }
+
+  template <typename char_t>
+  struct splits_iterator
+  {
+    char_t del;
+    std::basic_string_view<char_t> data;
+
+    constexpr splits_iterator &operator++()
+    {
+      if (data.size() != 0)
+      {
+        auto found = std::find(data.begin(), data.end(), del);
+        data = std::basic_string_view<char_t>(
+            found == data.end() ? found : found + 1, data.end());
+      }
+
+      return *this;
+    }
+
+    constexpr const std::basic_string_view<char_t> operator*()
+    {
+      return std::basic_string_view<char_t>(
+          data.begin(), std::find(data.begin(), data.end(), del));
+    }
+
+    constexpr splits_iterator operator++(int)
+    {
+      splits_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    constexpr friend bool operator==(
+        const splits_iterator &a,
+        const splits_iterator &b)
+    {
+      return a.data.data() == b.data.data();
+    }
+
+    constexpr friend bool operator!=(
+        const splits_iterator &a,
+        const splits_iterator &b)
+    {
+      return not(a == b);
+    }
+  };
+
+  template <typename char_t>
+  struct splits
+  {
+    char_t del;
+    std::basic_string_view<char_t> data;
+
+    constexpr splits_iterator<char_t> begin() const
+    {
+      return splits_iterator<char_t>{del, data};
+    }
+
+    constexpr splits_iterator<char_t> end() const
+    {
+      return splits_iterator<char_t>{del, data.substr(data.size())};
+    }
+  };
+
+  template <typename char_t>
+  constexpr splits<char_t> split(
+      const std::basic_string_view<char_t> &data,
+      const char_t &del)
+  {
+    return splits<char_t>{del, data};
+  }
+
+  template <typename char_t>
+  struct paths_iterator
+  {
+    splits_iterator<char_t> sit;
+
+    constexpr paths_iterator &operator++()
+    {
+      ++sit;
+      return *this;
+    }
+
+    constexpr paths_iterator operator++(int)
+    {
+      paths_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    constexpr path<char_t> operator*()
+    {
+      return parse_path(*sit);
+    }
+
+    constexpr friend bool operator==(
+        const paths_iterator &a,
+        const paths_iterator &b)
+    {
+      return a.sit == b.sit;
+    }
+
+    constexpr friend bool operator!=(
+        const paths_iterator &a,
+        const paths_iterator &b)
+    {
+      return not(a == b);
+    }
+  };
+
+  template <typename char_t>
+  struct paths
+  {
+    splits<char_t> spl;
+
+    constexpr paths_iterator<char_t> begin() const { return {spl.begin()}; }
+    constexpr paths_iterator<char_t> end() const { return {spl.end()}; }
+  };
+
+  template <typename char_t>
+  constexpr paths<char_t> split_paths(const std::basic_string_view<char_t> &pths)
+  {
+    return paths<char_t>{split(pths, char_t('.'))};
+  }
+
+  template <typename char_t>
+  root_view<char_t> getone(
+      const path<char_t> &pth,
+      const root_view<char_t> &view)
+  {
+    std::size_t cnt = 0;
+
+    if (view.type() == clon_type::list)
+      for (root_view<char_t> &&child : childs(view))
+        if (child.name() == pth.name)
+        {
+          if (cnt == pth.min)
+            return child;
+          else
+            ++cnt;
+        }
+
+    return make_rview(view, no_root);
+  }
+
+  template <typename char_t>
+  root_view<char_t> getone(
+      const std::basic_string_view<char_t> &pth,
+      const root_view<char_t> &view)
+  {
+    return getone(parse_path(pth), view);
+  }
+
+  constexpr std::size_t index_threshold = 32;
+
+  // positions of the children of the list node at parent, grouped by name
+  // in document order, built once and kept in the root.
+  template <typename char_t>
+  const child_index<char_t> &index_of(
+      root_node<char_t> &root,
+      const std::size_t &parent)
+  {
+    auto found = root.indexes.find(parent);
+
+    if (found != root.indexes.end())
+      return found->second;
+
+    child_index<char_t> &index = root.indexes[parent];
+
+    for (std::size_t i = root.nodes[parent].child; i != no_next; i = root.nodes[i].next)
+      index[root.nodes[i].name].push_back(i);
+
+    return index;
+  }
+
+  template <typename char_t>
+  bool should_index(
+      const root_node<char_t> &root,
+      const std::size_t &parent)
+  {
+    if (not root.index_lists)
+      return false;
+
+    std::size_t count = 0;
+
+    for (std::size_t i = root.nodes[parent].child; i != no_next and count < index_threshold; i = root.nodes[i].next)
+      ++count;
+
+    return count == index_threshold;
+  }
+
+  template <typename char_t>
+  const child_index<char_t> *index_for(
+      root_node<char_t> &root,
+      const std::size_t &parent)
+  {
+    if (root.indexes.empty() and not root.index_lists)
+      return nullptr;
+
+    auto found = root.indexes.find(parent);
+
+    if (found != root.indexes.end())
+      return &found->second;
+
+    if (not root.frozen and should_index(root, parent))
+      return &index_of(root, parent);
+
+    return nullptr;
+  }
+
+  inline void handle_frozen()
+  {
+    throw std::runtime_error("a frozen document can not be modified");
+  }
+
+  // decodes every value and builds every index lookups could build later,
+  // so that nothing writes into the root once it is frozen.
+  template <typename char_t>
+  void freeze(root_node<char_t> &root)
+  {
+    for (std::size_t i = 0; i < root.nodes.size(); ++i)
+    {
+      const root_view<char_t> view = make_rview(root, i);
+
+      switch (view.type())
+      {
+      case clon_type::no_boolean:
+        view.template as_<boolean>();
+        break;
+      case clon_type::no_number:
+        view.template as_<number>();
+        break;
+      case clon_type::no_real:
+        view.template as_<real>();
+        break;
+      case clon_type::no_string:
+        view.template as_<string<char_t>>();
+        break;
+      case clon_type::list:
+        if (should_index(root, i))
+          index_of(root, i);
+        break;
+      default:
+        break;
+      }
+    }
+
+    root.frozen = true;
+  }
+
+  template <typename char_t>
+  std::size_t find_indexed(
+      const child_index<char_t> &index,
+      const path<char_t> &pth)
+  {
+    auto found = index.find(pth.name);
+
+    return found != index.end() and pth.min < found->second.size()
+               ? found->second[pth.min]
+               : no_root;
+  }
+
+  template <typename char_t>
+  std::size_t find_child(
+      const root_view<char_t> &parent,
+      const path<char_t> &pth,
+      const bool &by_id)
+  {
+    const node_list<char_t> &nodes = parent.root->nodes;
+    std::size_t cnt = 0;
+
+    if (const child_index<char_t> *index = index_for(*parent.root, parent.index))
+      return find_indexed(*index, pth);
+
+    if (by_id and pth.id != no_name)
+    {
+      const std::pmr::vector<std::uint32_t> &ids = parent.root->name_ids;
+
+      for (std::size_t i = parent.child(); i != no_next; i = nodes[i].next)
+        if (ids[i] == pth.id and cnt++ == pth.min)
+          return i;
+    }
+    else
+      for (std::size_t i = parent.child(); i != no_next; i = nodes[i].next)
+        if (nodes[i].name == pth.name and cnt++ == pth.min)
+          return i;
+
+    return no_root;
+  }
+
+  template <typename char_t, typename paths_t>
+  root_view<char_t> get(
+      const paths_t &pths,
+      const root_view<char_t> &view,
+      const name_table<char_t> *bound = nullptr)
+  {
+    const bool by_id = bound != nullptr and view.root->names == bound;
+    root_view<char_t> vfound = view;
+
+    for (const path<char_t> &pth : pths)
+    {
+      if (not vfound.template is_<list>())
+        return make_rview(view, no_root);
+
+      vfound.index = find_child(vfound, pth, by_id);
+
+      if (vfound.index == no_root)
+        return make_rview(view, no_root);
+    }
+
+    return vfound;
+  }
+
+  template <typename char_t>
+  root_view<char_t> get(
+      const std::basic_string_view<char_t> &pths,
+      const root_view<char_t> &view)
+  {
+    return get<char_t>(split_paths(pths), view);
+  }
+
+  template <typename char_t>
+  class compiled_path
+  {
+    std::basic_string<char_t> text;
+    std::vector<path<char_t>> segments;
+    const name_table<char_t> *bound = nullptr;
+
+  public:
+    explicit compiled_path(const std::basic_string_view<char_t> &pths)
+        : text(pths)
+    {
+      compile();
+    }
+
+    compiled_path(const compiled_path &other)
+        : compiled_path(std::basic_string_view<char_t>(other.text))
+    {
+      if (other.bound != nullptr)
+        bind(*other.bound);
+    }
+
+    compiled_path &operator=(const compiled_path &other)
+    {
+      return *this = compiled_path(other);
+    }
+
+    compiled_path &operator=(compiled_path &&other)
+    {
+      text = std::move(other.text);
+      compile();
+
+      if (other.bound != nullptr)
+        bind(*other.bound);
+
+      return *this;
+    }
+
+  public:
+    // resolves every name against names once, so documents parsed with
+    // the same table are walked comparing ids instead of strings.
+    compiled_path &bind(const name_table<char_t> &names)
+    {
+      bound = &names;
+
+      for (path<char_t> &pth : segments)
+        pth.id = names.find(pth.name);
+
+      return *this;
+    }
+
+    const name_table<char_t> *table() const { return bound; }
+    auto begin() const { return segments.begin(); }
+    auto end() const { return segments.end(); }
+    std::size_t size() const { return segments.size(); }
+    bool empty() const { return segments.empty(); }
+    const path<char_t> &operator[](const std::size_t &i) const { return segments[i]; }
+
+  private:
+    void compile()
+    {
+      segments.clear();
+      bound = nullptr;
+
+      for (const path<char_t> &pth : split_paths(std::basic_string_view<char_t>(text)))
+        segments.push_back(pth);
+    }
+  };
+
+  struct match_cursor
+  {
+    const std::vector<std::size_t> *positions = nullptr;
+    std::size_t next = no_next;
+    std::size_t count = 0;
+  };
+
+  // walks the tree depth first keeping one cursor per segment, so each
+  // list is scanned once whatever the number of matches below it.
+  template <typename char_t, typename view_t, typename paths_t>
+  class matches_iterator
+  {
+    root_node<char_t> *root = nullptr;
+    const paths_t *pths = nullptr;
+    std::vector<match_cursor> cursors;
+    std::size_t current = no_root;
+
+  public:
+    using value_type = view_t;
+    using difference_type = std::ptrdiff_t;
+
+    matches_iterator() = default;
+
+    matches_iterator(
+        root_node<char_t> *_root,
+        const paths_t *_pths,
+        const std::size_t &start)
+        : root(_root), pths(_pths), cursors(_pths->size())
+    {
+      if (pths->empty())
+        current = start;
+      else
+      {
+        open(0, start);
+        advance(0);
+      }
+    }
+
+  public:
+    view_t operator*() const
+    {
+      return view_t(make_rview(*root, current));
+    }
+
+    matches_iterator &operator++()
+    {
+      if (pths->empty())
+        current = no_root;
+      else
+        advance(pths->size() - 1);
+
+      return *this;
+    }
+
+    matches_iterator operator++(int)
+    {
+      matches_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    friend bool operator==(
+        const matches_iterator &it,
+        std::default_sentinel_t)
+    {
+      return it.current == no_root;
+    }
+
+  private:
+    void open(const std::size_t &level, const std::size_t &parent)
+    {
+      match_cursor &c = cursors[level];
+      c = match_cursor{};
+
+      if (make_rview(*root, parent).type() != clon_type::list)
+        return;
+
+      if (const child_index<char_t> *index = index_for(*root, parent))
+      {
+        auto found = index->find((*pths)[level].name);
+
+        if (found != index->end())
+          c.positions = &found->second;
+      }
+      else
+        c.next = root->nodes[parent].child;
+    }
+
+    std::size_t step(const std::size_t &level)
+    {
+      match_cursor &c = cursors[level];
+      const path<char_t> &pth = (*pths)[level];
+
+      if (c.positions != nullptr)
+      {
+        const std::size_t i = std::max(c.count, pth.min);
+
+        if (i > pth.max or i >= c.positions->size())
+          return no_root;
+
+        c.count = i + 1;
+        return (*c.positions)[i];
+      }
+
+      while (c.next != no_next)
+      {
+        const std::size_t i = c.next;
+        c.next = root->nodes[i].next;
+
+        if (root->nodes[i].name == pth.name)
+        {
+          const std::size_t n = c.count++;
+
+          if (n > pth.max)
+            c.next = no_next;
+          else if (n >= pth.min)
+            return i;
+        }
+      }
+
+      return no_root;
+    }
+
+    void advance(std::size_t level)
+    {
+      while (true)
+      {
+        const std::size_t i = step(level);
+
+        if (i == no_root)
+        {
+          if (level == 0)
+          {
+            current = no_root;
+            return;
+          }
+
+          --level;
+        }
+        else if (level + 1 == pths->size())
+        {
+          current = i;
+          return;
+        }
+        else
+          open(++level, i);
+      }
+    }
+  };
+
+  template <typename char_t, typename view_t, typename paths_t>
+  class matches
+  {
+    root_node<char_t> *root;
+    std::size_t start;
+    paths_t pths;
+
+  public:
+    matches(const root_view<char_t> &view, const paths_t &_pths)
+        : root(view.root), start(view.index), pths(_pths) {}
+
+  public:
+    matches_iterator<char_t, view_t, paths_t> begin() const
+    {
+      return start == no_root
+                 ? matches_iterator<char_t, view_t, paths_t>()
+                 : matches_iterator<char_t, view_t, paths_t>(root, &pths, start);
+    }
+
+    std::default_sentinel_t end() const
+    {
+      return std::default_sentinel;
+    }
+  };
+
+  struct memory_report
+  {
+    std::size_t buffer = 0;
+    std::size_t nodes = 0;
+    std::size_t names = 0;
+    std::size_t updates = 0;
+    std::size_t indexes = 0;
+
+    std::size_t total() const
+    {
+      return buffer + nodes + names + updates + indexes;
+    }
+  };
+
+  template <typename key_t, typename value_t>
+  std::size_t memory_of(const std::unordered_map<key_t, value_t> &map)
+  {
+    return map.empty()
+               ? 0
+               : map.bucket_count() * sizeof(void *) +
+                     map.size() * (sizeof(std::pair<const key_t, value_t>) + sizeof(void *));
+  }
+
+  template <typename char_t>
+  memory_report memory_of(const root_node<char_t> &root)
+  {
+    memory_report report;
+
+    if (not std::holds_alternative<std::basic_string_view<char_t>>(root.buff))
+      report.buffer = view_of(root.buff).size() * sizeof(char_t);
+
+    report.nodes = root.nodes.capacity() * sizeof(node<char_t>);
+    report.names = root.name_ids.capacity() * sizeof(std::uint32_t);
+
+    report.updates = root.updated;
+
+    report.indexes = memory_of(root.indexes);
+
+    for (const auto &[parent, index] : root.indexes)
+    {
+      report.indexes += memory_of(index);
+
+      for (const auto &[name, positions] : index)
+        report.indexes += positions.capacity() * sizeof(std::size_t);
+    }
+
+    return report;
+  }
+
+  template <typename char_t, std::size_t n>
+  struct fixed_path
+  {
+    char_t data[n];
+
+    consteval fixed_path(const char_t (&s)[n])
+    {
+      std::copy_n(s, n, data);
+    }
+
+    consteval std::basic_string_view<char_t> view() const
+    {
+      return std::basic_string_view<char_t>(data, n - 1);
+    }
+  };
+
+  template <typename char_t, std::size_t n>
+  struct static_path
+  {
+    std::array<path<char_t>, n> segments;
+
+    constexpr auto begin() const { return segments.begin(); }
+    constexpr auto end() const { return segments.end(); }
+    constexpr std::size_t size() const { return n; }
+    constexpr bool empty() const { return n == 0; }
+    constexpr const path<char_t> &operator[](const std::size_t &i) const { return segments[i]; }
+  };
+
+  template <fixed_path pths>
+  consteval auto make_static_path()
+  {
+    using char_t = std::remove_cvref_t<decltype(pths.data[0])>;
+    constexpr std::size_t n = std::ranges::count(pths.view(), '.') + 1;
+    static_path<char_t, n> spth;
+    std::size_t i = 0;
+
+    for (const path<char_t> &pth : split_paths(pths.view()))
+      spth.segments[i++] = pth;
+
+    return spth;
+  }
+
+  constexpr std::uint32_t no_next32 = maxof<std::uint32_t>;
+
+  struct tape_span
+  {
+    std::uint32_t offset = 0;
+    std::uint32_t length = 0;
+  };
+
+  // compact layout : 21 bytes per node in separate columns. a list has no
+  // child column since its first child is always the node right after it.
+  template <typename char_t>
+  struct tape
+  {
+    source<char_t> buff;
+    std::vector<tape_span> names;
+    std::vector<tape_span> values;
+    std::vector<std::uint32_t> next;
+    std::vector<std::uint8_t> types;
+    bool eager_values = false;
+    std::size_t max_depth = default_max_depth;
+    std::vector<number> decoded;
+  };
+
+  template <typename char_t>
+  class tape_builder
+  {
+    tape<char_t> &tp;
+    const char_t *base;
+    std::uint32_t open = no_next32;
+    std::uint32_t last = no_next32;
+
+  public:
+    explicit tape_builder(tape<char_t> &_tp)
+        : tp(_tp), base(view_of(_tp.buff).data()) {}
+
+  public:
+    void on_open(const std::basic_string_view<char_t> &name)
+    {
+      const std::uint32_t index = static_cast<std::uint32_t>(tp.next.size());
+
+      if (last != no_next32)
+        tp.next[last] = index;
+      else if (open != no_next32)
+        tp.types[open] = static_cast<std::uint8_t>(clon_type::list);
+
+      tp.names.push_back(span_of(name));
+      tp.values.push_back({});
+
+      if (tp.eager_values)
+        tp.decoded.push_back(0);
+
+      tp.next.push_back(open);
+      tp.types.push_back(static_cast<std::uint8_t>(clon_type::none));
+      open = index;
+      last = no_next32;
+    }
+
+    void on_boolean(const std::basic_string_view<char_t> &valv)
+    {
+      on_value(clon_type::no_boolean, valv);
+
+      if (tp.eager_values)
+        tp.decoded.back() = to_boolean(valv);
+    }
+
+    void on_number(const std::basic_string_view<char_t> &valv)
+    {
+      const bool real_number = is_real(valv);
+      on_value(real_number ? clon_type::no_real : clon_type::no_number, valv);
+
+      if (tp.eager_values)
+        tp.decoded.back() = real_number
+                                ? std::bit_cast<number>(to_real(valv))
+                                : to_number(valv);
+    }
+
+    void on_string(const std::basic_string_view<char_t> &valv)
+    {
+      on_value(clon_type::no_string, valv);
+    }
+
+    void on_close()
+    {
+      last = open;
+      open = tp.next[last];
+      tp.next[last] = no_next32;
+    }
+
+  private:
+    tape_span span_of(const std::basic_string_view<char_t> &v) const
+    {
+      return {static_cast<std::uint32_t>(v.data() - base),
+              static_cast<std::uint32_t>(v.size())};
+    }
+
+    void on_value(
+        const clon_type &type,
+        const std::basic_string_view<char_t> &valv)
+    {
+      tp.types.back() = static_cast<std::uint8_t>(type);
+      tp.values.back() = span_of(valv);
+    }
+  };
+
+  template <typename char_t>
+  void parse(tape<char_t> &tp)
+  {
+    const std::basic_string_view<char_t> data = view_of(tp.buff);
+
+    if (data.size() >= no_next32)
+      throw std::runtime_error("document too large for the compact layout");
+
+    const std::size_t count = std::count(data.begin(), data.end(), '(');
+    tp.names.reserve(count);
+    tp.values.reserve(count);
+    tp.next.reserve(count);
+    tp.types.reserve(count);
+
+    if (tp.eager_values)
+      tp.decoded.reserve(count);
+
+    tape_builder<char_t> builder(tp);
+    parse_events(data, builder, tp.max_depth);
+  }
+
+  template <typename char_t>
+  struct tape_view
+  {
+    const tape<char_t> *root;
+    std::size_t index;
+
+    using view = std::basic_string_view<char_t>;
+
+    view name() const
+    {
+      return view_of(root->buff).substr(root->names[index].offset, root->names[index].length);
+    }
+
+    view valv() const
+    {
+      return view_of(root->buff).substr(root->values[index].offset, root->values[index].length);
+    }
+
+    std::size_t next() const
+    {
+      return root->next[index] == no_next32 ? no_next : root->next[index];
+    }
+
+    std::size_t child() const
+    {
+      return type() == clon_type::list ? index + 1 : no_child;
+    }
+
+    clon_type type() const
+    {
+      return index == no_root
+                 ? clon_type::none
+                 : static_cast<clon_type>(root->types[index]);
+    }
+
+    // nothing is cached in the compact layout : values decode on each call
+    // unless they were all decoded by the parse.
+    template <typename type_t>
+    type_t as_() const
+    {
+      if constexpr (std::is_same_v<type_t, boolean>)
+        if (type() == clon_type::no_boolean)
+          return root->decoded.empty()
+                     ? to_boolean(valv())
+                     : root->decoded[index] != 0;
+
+      if constexpr (std::is_same_v<type_t, string<char_t>>)
+        if (type() == clon_type::no_string)
+          return valv();
+
+      if constexpr (std::is_same_v<type_t, number>)
+        if (type() == clon_type::no_number)
+          return root->decoded.empty()
+                     ? to_number(valv())
+                     : root->decoded[index];
+
+      if constexpr (std::is_same_v<type_t, real>)
+        if (type() == clon_type::no_real)
+          return root->decoded.empty()
+                     ? to_real(valv())
+                     : std::bit_cast<real>(root->decoded[index]);
+
+      throw std::bad_variant_access();
+    }
+  };
+
+  // path lookup for the read only layouts, child after child since they
+  // have no index.
+  template <typename char_t, typename paths_t, typename view_t>
+  view_t find_path(
+      const paths_t &pths,
+      const view_t &view)
+  {
+    view_t vfound = view;
+
+    for (const path<char_t> &pth : pths)
+    {
+      if (vfound.type() != clon_type::list)
+        return {view.root, no_root};
+
+      std::size_t cnt = 0;
+      std::size_t found = no_root;
+
+      for (const view_t &child : childs(vfound))
+        if (child.name() == pth.name and cnt++ == pth.min)
+        {
+          found = child.index;
+          break;
+        }
+
+      if (found == no_root)
+        return {view.root, no_root};
+
+      vfound.index = found;
+    }
+
+    return vfound;
+  }
+
+  template <typename char_t, typename paths_t>
+  tape_view<char_t> get(
+      const paths_t &pths,
+      const tape_view<char_t> &view)
+  {
+    return find_path<char_t>(pths, view);
+  }
+
+  template <typename char_t>
+  void format_of(
+      fmt::formatter_context<char_t> &ctx,
+      const tape_view<char_t> &view)
+  {
+    format_view(ctx, view);
+  }
+
+  template <typename char_t>
+  memory_report memory_of(const tape<char_t> &tp)
+  {
+    memory_report report;
+
+    if (not std::holds_alternative<std::basic_string_view<char_t>>(tp.buff))
+      report.buffer = view_of(tp.buff).size() * sizeof(char_t);
+
+    report.nodes = tp.names.capacity() * sizeof(tape_span) +
+                   tp.values.capacity() * sizeof(tape_span) +
+                   tp.next.capacity() * sizeof(std::uint32_t) +
+                   tp.types.capacity() * sizeof(std::uint8_t) +
+                   tp.decoded.capacity() * sizeof(number);
+
+    return report;
+  }
+
+  // binary layout : a header (the units c l o n, the version, the flags)
+  // then the names when binary_dictionary is set, then the nodes in
+  // document order. a node is a tag (its binary_type, with binary_last
+  // when no sibling follows), its name (an id in the names, or a length
+  // and the chars) and its value : a zigzag varint for a number, eight
+  // units for a real, a length and the chars for a string, and for a
+  // list the count of units of its children on four units, the children
+  // coming right after. tags, varints and lengths only use eight bits of
+  // a unit, so that the layout is the same for any char_t.
+  enum struct binary_type : std::uint8_t
+  {
+    none,
+    no,
+    yes,
+    number,
+    real,
+    string,
+    list
+  };
+
+  constexpr std::uint8_t binary_last = 0x10;
+  constexpr std::uint8_t binary_mask = 0x0f;
+  constexpr std::uint8_t binary_version = 1;
+  constexpr std::uint8_t binary_dictionary = 0x01;
+  constexpr std::size_t binary_header = 6;
+  constexpr std::size_t binary_skip = 4;
+
+  struct binary_options
+  {
+    bool dictionary = false;
+  };
+
+  template <typename char_t>
+  constexpr char_t binary_magic[] = {'c', 'l', 'o', 'n'};
+
+  inline void handle_bad_binary()
+  {
+    throw std::runtime_error("malformed binary clon");
+  }
+
+  template <typename char_t>
+  std::uint8_t unit_of(const char_t &c)
+  {
+    return static_cast<std::uint8_t>(c);
+  }
+
+  template <typename char_t>
+  void put_unit(std::basic_string<char_t> &out, const std::uint64_t &u)
+  {
+    out.push_back(static_cast<char_t>(u & 0xff));
+  }
+
+  template <typename char_t>
+  void put_varint(std::basic_string<char_t> &out, std::uint64_t u)
+  {
+    while (u >= 0x80)
+    {
+      put_unit(out, (u & 0x7f) | 0x80);
+      u >>= 7;
+    }
+
+    put_unit(out, u);
+  }
+
+  template <typename char_t>
+  void put_fixed(
+      std::basic_string<char_t> &out,
+      const std::uint64_t &u,
+      const std::size_t &n)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      put_unit(out, u >> (8 * i));
+  }
+
+  template <typename char_t>
+  void put_chars(
+      std::basic_string<char_t> &out,
+      const std::basic_string_view<char_t> &chars)
+  {
+    put_varint(out, chars.size());
+    out.append(chars);
+  }
+
+  template <typename char_t>
+  std::uint64_t read_varint(const char_t *data, std::size_t &pos)
+  {
+    std::uint64_t u = 0;
+
+    for (unsigned shift = 0;; shift += 7)
+    {
+      const std::uint8_t unit = unit_of(data[pos++]);
+      u |= static_cast<std::uint64_t>(unit & 0x7f) << shift;
+
+      if (unit < 0x80)
+        return u;
+    }
+  }
+
+  template <typename char_t>
+  std::uint64_t read_fixed(
+      const char_t *data,
+      const std::size_t &pos,
+      const std::size_t &n)
+  {
+    std::uint64_t u = 0;
+
+    for (std::size_t i = 0; i < n; ++i)
+      u |= static_cast<std::uint64_t>(unit_of(data[pos + i])) << (8 * i);
+
+    return u;
+  }
+
+  constexpr std::uint64_t zigzag(const number &n)
+  {
+    return (static_cast<std::uint64_t>(n) << 1) ^ static_cast<std::uint64_t>(n >> 63);
+  }
+
+  constexpr number unzigzag(const std::uint64_t &u)
+  {
+    return static_cast<number>((u >> 1) ^ (0 - (u & 1)));
+  }
+
+  // any view (root_view, tape_view, binary_view) to the binary layout,
+  // the view being the root, so without a sibling.
+  template <typename char_t, typename view_t>
+  std::basic_string<char_t> write_binary(
+      const view_t &view,
+      const binary_options &opts)
+  {
+    std::basic_string<char_t> out;
+    std::unordered_map<std::basic_string_view<char_t>, std::uint32_t> ids;
+    std::vector<std::size_t> skips;
+
+    out.append(binary_magic<char_t>, 4);
+    put_unit(out, binary_version);
+    put_unit(out, opts.dictionary ? binary_dictionary : 0);
+
+    if (view.index == no_root)
+      return out;
+
+    if (opts.dictionary)
+    {
+      std::vector<std::basic_string_view<char_t>> names;
+
+      walk(
+          view,
+          [&ids, &names](const view_t &v, std::size_t) {
+            if (ids.try_emplace(v.name(), static_cast<std::uint32_t>(names.size())).second)
+              names.push_back(v.name());
+          },
+          [](const view_t &, std::size_t) {});
+
+      put_varint(out, names.size());
+
+      for (const std::basic_string_view<char_t> &name : names)
+        put_chars(out, name);
+    }
+
+    walk(
+        view,
+        [&out, &ids, &skips, &opts](const view_t &v, const std::size_t &depth) {
+          const std::size_t tag = out.size();
+          const bool last = depth == 0 or v.next() == no_next;
+          binary_type type = binary_type::none;
+
+          put_unit(out, last ? binary_last : 0);
+
+          if (opts.dictionary)
+            put_varint(out, ids.find(v.name())->second);
+          else
+            put_chars(out, v.name());
+
+          switch (v.type())
+          {
+          case clon_type::boolean:
+          case clon_type::no_boolean:
+            type = v.template as_<boolean>() ? binary_type::yes : binary_type::no;
+            break;
+          case clon_type::number:
+          case clon_type::no_number:
+            type = binary_type::number;
+            put_varint(out, zigzag(v.template as_<number>()));
+            break;
+          case clon_type::real:
+          case clon_type::no_real:
+            type = binary_type::real;
+            put_fixed(out, std::bit_cast<std::uint64_t>(real(v.template as_<real>())), 8);
+            break;
+          case clon_type::string:
+          case clon_type::no_string:
+            type = binary_type::string;
+            put_chars(out, std::basic_string_view<char_t>(v.valv()));
+            break;
+          case clon_type::list:
+            type = binary_type::list;
+            skips.push_back(out.size());
+            put_fixed(out, 0, binary_skip);
+            break;
+          case clon_type::none:
+            break;
+          }
+
+          out[tag] = static_cast<char_t>(unit_of(out[tag]) | static_cast<std::uint8_t>(type));
+        },
+        [&out, &skips](const view_t &, std::size_t) {
+          const std::size_t skip = skips.back();
+          const std::size_t length = out.size() - skip - binary_skip;
+          skips.pop_back();
+
+          if (length > maxof<std::uint32_t>)
+            throw std::runtime_error("document too large for the binary layout");
+
+          for (std::size_t i = 0; i < binary_skip; ++i)
+            out[skip + i] = static_cast<char_t>((length >> (8 * i)) & 0xff);
+        });
+
+    return out;
+  }
+
+  template <typename char_t>
+  struct binary
+  {
+    source<char_t> buff;
+    std::vector<std::basic_string_view<char_t>> names;
+    bool dictionary = false;
+    std::size_t first = no_root;
+    std::size_t max_depth = default_max_depth;
+  };
+
+  // bounds checked reads for load, which checks every node once so that
+  // views can then read without any check.
+  template <typename char_t>
+  struct binary_checker
+  {
+    std::basic_string_view<char_t> data;
+    std::size_t pos = 0;
+
+    std::uint8_t unit(const std::size_t &limit)
+    {
+      if (pos >= limit)
+        handle_bad_binary();
+
+      return unit_of(data[pos++]);
+    }
+
+    std::uint64_t varint(const std::size_t &limit)
+    {
+      std::uint64_t u = 0;
+
+      for (unsigned shift = 0; shift < 64; shift += 7)
+      {
+        const std::uint8_t b = unit(limit);
+        u |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+
+        if (b < 0x80)
+          return u;
+      }
+
+      handle_bad_binary();
+      return u;
+    }
+
+    void skip(const std::uint64_t &n, const std::size_t &limit)
+    {
+      if (n > limit - pos)
+        handle_bad_binary();
+
+      pos += n;
+    }
+  };
+
+  template <typename char_t>
+  void load(binary<char_t> &bin)
+  {
+    const std::basic_string_view<char_t> data = view_of(bin.buff);
+    binary_checker<char_t> check{data};
+
+    if (data.size() < binary_header or
+        data.substr(0, 4) != std::basic_string_view<char_t>(binary_magic<char_t>, 4) or
+        unit_of(data[4]) != binary_version)
+      handle_bad_binary();
+
+    bin.dictionary = unit_of(data[5]) & binary_dictionary;
+    bin.names.clear();
+    check.pos = binary_header;
+
+    if (bin.dictionary)
+      for (std::uint64_t count = check.varint(data.size()); count != 0; --count)
+      {
+        const std::uint64_t length = check.varint(data.size());
+        const std::size_t from = check.pos;
+        check.skip(length, data.size());
+        bin.names.push_back(data.substr(from, length));
+      }
+
+    bin.first = check.pos == data.size() ? no_root : check.pos;
+
+    std::size_t limit = data.size();
+    std::vector<std::size_t> limits;
+
+    while (check.pos != data.size())
+    {
+      const std::uint8_t tag = check.unit(limit);
+      const std::uint64_t name = check.varint(limit);
+      std::size_t end = 0;
+
+      if (bin.dictionary and name >= bin.names.size())
+        handle_bad_binary();
+
+      if (not bin.dictionary)
+        check.skip(name, limit);
+
+      switch (static_cast<binary_type>(tag & binary_mask))
+      {
+      case binary_type::none:
+      case binary_type::no:
+      case binary_type::yes:
+        break;
+      case binary_type::number:
+        check.varint(limit);
+        break;
+      case binary_type::real:
+        check.skip(8, limit);
+        break;
+      case binary_type::string:
+        check.skip(check.varint(limit), limit);
+        break;
+      case binary_type::list:
+        check.skip(binary_skip, limit);
+        end = read_fixed(data.data(), check.pos - binary_skip, binary_skip);
+
+        if (end == 0 or end > limit - check.pos)
+          handle_bad_binary();
+
+        end += check.pos;
+        break;
+      default:
+        handle_bad_binary();
+      }
+
+      if (tag & ~(binary_mask | binary_last))
+        handle_bad_binary();
+
+      if (((tag & binary_last) != 0) != ((end == 0 ? check.pos : end) == limit))
+        handle_bad_binary();
+
+      if (end != 0)
+      {
+        if (limits.size() == bin.max_depth)
+          handle_too_deep();
+
+        limits.push_back(limit);
+        limit = end;
+        continue;
+      }
+
+      while (check.pos == limit and not limits.empty())
+      {
+        limit = limits.back();
+        limits.pop_back();
+      }
+    }
+  }
+
+  // the text of a value of the binary layout : a string is viewed in
+  // place, any other value is printed into digits.
+  template <typename char_t>
+  struct binary_text
+  {
+    const char_t *data = nullptr;
+    std::size_t length = 0;
+    std::array<char_t, 32> digits;
+
+    std::size_t size() const
+    {
+      return length;
+    }
+
+    operator std::basic_string_view<char_t>() const
+    {
+      return {data == nullptr ? digits.data() : data, length};
+    }
+  };
+
+  template <typename char_t>
+  std::size_t length_of(const binary_text<char_t> &text)
+  {
+    return text.size();
+  }
+
+  template <typename char_t>
+  void format_of(
+      fmt::formatter_context<char_t> &ctx,
+      const binary_text<char_t> &text)
+  {
+    const std::basic_string_view<char_t> v = text;
+    ctx.append(v.data(), v.size());
+  }
+
+  template <typename char_t>
+  struct binary_view
+  {
+    const binary<char_t> *root;
+    std::size_t index;
+
+    using view = std::basic_string_view<char_t>;
+
+    const char_t *data() const
+    {
+      return view_of(root->buff).data();
+    }
+
+    std::uint8_t tag() const
+    {
+      return unit_of(data()[index]);
+    }
+
+    binary_type btype() const
+    {
+      return static_cast<binary_type>(tag() & binary_mask);
+    }
+
+    view name() const
+    {
+      std::size_t pos = index + 1;
+      const std::uint64_t name = read_varint(data(), pos);
+
+      return root->dictionary
+                 ? root->names[name]
+                 : view(data() + pos, name);
+    }
+
+    std::size_t value_pos() const
+    {
+      std::size_t pos = index + 1;
+      const std::uint64_t name = read_varint(data(), pos);
+      return root->dictionary ? pos : pos + name;
+    }
+
+    std::size_t end() const
+    {
+      std::size_t pos = value_pos();
+
+      switch (btype())
+      {
+      case binary_type::number:
+        read_varint(data(), pos);
+        return pos;
+      case binary_type::real:
+        return pos + 8;
+      case binary_type::string:
+        pos += read_varint(data(), pos);
+        return pos;
+      case binary_type::list:
+        return pos + binary_skip + read_fixed(data(), pos, binary_skip);
+      default:
+        return pos;
+      }
+    }
+
+    std::size_t next() const
+    {
+      return (tag() & binary_last) ? no_next : end();
+    }
+
+    std::size_t child() const
+    {
+      return btype() == binary_type::list ? value_pos() + binary_skip : no_child;
+    }
+
+    clon_type type() const
+    {
+      if (index == no_root)
+        return clon_type::none;
+
+      switch (btype())
+      {
+      case binary_type::no:
+      case binary_type::yes:
+        return clon_type::boolean;
+      case binary_type::number:
+        return clon_type::number;
+      case binary_type::real:
+        return clon_type::real;
+      case binary_type::string:
+        return clon_type::string;
+      case binary_type::list:
+        return clon_type::list;
+      default:
+        return clon_type::none;
+      }
+    }
+
+    // a real always prints with a '.' or an exponent so that it reads
+    // back as a real.
+    binary_text<char_t> valv() const
+    {
+      binary_text<char_t> text;
+      char digits[32];
+      char *last = digits;
+
+      switch (btype())
+      {
+      case binary_type::string:
+      {
+        std::size_t pos = value_pos();
+        text.length = read_varint(data(), pos);
+        text.data = data() + pos;
+        return text;
+      }
+      case binary_type::no:
+      case binary_type::yes:
+        last = std::copy_n(btype() == binary_type::yes ? "true" : "false", btype() == binary_type::yes ? 4 : 5, digits);
+        break;
+      case binary_type::number:
+        last = std::to_chars(digits, digits + sizeof(digits), as_<number>()).ptr;
+        break;
+      case binary_type::real:
+        last = std::to_chars(digits, digits + sizeof(digits), as_<real>()).ptr;
+
+        if (std::find_if(digits, last, [](const char &c) { return c == '.' or c == 'e' or c == 'n' or c == 'i'; }) == last)
+          last = std::copy_n(".0", 2, last);
+        break;
+      default:
+        break;
+      }
+
+      text.length = std::copy(digits, last, text.digits.begin()) - text.digits.begin();
+      return text;
+    }
+
+    template <typename type_t>
+    type_t as_() const
+    {
+      if constexpr (std::is_same_v<type_t, boolean>)
+        if (type() == clon_type::boolean)
+          return btype() == binary_type::yes;
+
+      if constexpr (std::is_same_v<type_t, string<char_t>>)
+        if (type() == clon_type::string)
+          return valv();
+
+      if constexpr (std::is_same_v<type_t, number>)
+        if (type() == clon_type::number)
+        {
+          std::size_t pos = value_pos();
+          return unzigzag(read_varint(data(), pos));
+        }
+
+      if constexpr (std::is_same_v<type_t, real>)
+        if (type() == clon_type::real)
+          return std::bit_cast<real>(read_fixed(data(), value_pos(), 8));
+
+      throw std::bad_variant_access();
+    }
+  };
+
+  template <typename char_t, typename paths_t>
+  binary_view<char_t> get(
+      const paths_t &pths,
+      const binary_view<char_t> &view)
+  {
+    return find_path<char_t>(pths, view);
+  }
+
+  template <typename char_t>
+  void format_of(
+      fmt::formatter_context<char_t> &ctx,
+      const binary_view<char_t> &view)
+  {
+    format_view(ctx, view);
+  }
+
+  template <typename char_t>
+  memory_report memory_of(const binary<char_t> &bin)
+  {
+    memory_report report;
+
+    if (not std::holds_alternative<std::basic_string_view<char_t>>(bin.buff))
+      report.buffer = view_of(bin.buff).size() * sizeof(char_t);
+
+    report.names = bin.names.capacity() * sizeof(std::basic_string_view<char_t>);
+    return report;
+  }
+}
+
+namespace clon
+{
+  using clon_type = detail::clon_type;
+  using write_mode = detail::write_mode;
+  using binary_options = detail::binary_options;
+  using number = detail::number;
+  template <typename char_t>
+  using string = detail::string<char_t>;
+  using list = detail::list;
+  using boolean = detail::boolean;
+  using real = detail::real;
+
+  template <typename char_t>
+  using basic_name_table = detail::name_table<char_t>;
+  using name_table = basic_name_table<char>;
+  using wname_table = basic_name_table<wchar_t>;
+
+  // names : interns every name into a table shared with other documents,
+  // which must outlive them, so bound compiled paths compare ids.
+  // index_lists : indexes wide lists by name on their first lookup.
+  // eager_values : decodes every number and boolean while parsing so
+  // reads never write to the document.
+  // threads : parses documents of a megabyte or more on that many threads.
+  // resource : upstream of the nodes and of the arena of updated values.
+  // max_depth : nodes nested deeper, the root being at depth 1, fail the
+  // parse with an error.
+  template <typename char_t>
+  using basic_parse_options = detail::parse_options<char_t>;
+  using parse_options = basic_parse_options<char>;
+  using wparse_options = basic_parse_options<wchar_t>;
+
+  using memory_report = detail::memory_report;
+
+  template <typename char_t>
+  using basic_compiled_path = detail::compiled_path<char_t>;
+  using compiled_path = basic_compiled_path<char>;
+  using wcompiled_path = basic_compiled_path<wchar_t>;
+
+  template <typename char_t>
+  class basic_clon_view
+  {
+    detail::root_view<char_t> view;
+
+  public:
+    explicit basic_clon_view(
+        const detail::root_view<char_t> &_v)
+        : view(_v) {}
+
+  public:
+    basic_clon_view<char_t> operator[](
+        const std::basic_string_view<char_t> &pth) const
+    {
+      return basic_clon_view<char_t>(detail::get(pth, view));
+    }
+
+    basic_clon_view<char_t> operator[](
+        const basic_compiled_path<char_t> &pth) const
+    {
+      return basic_clon_view<char_t>(detail::get<char_t>(pth, view, pth.table()));
+    }
+
+    template <std::size_t n>
+    basic_clon_view<char_t> operator[](
+        const detail::static_path<char_t, n> &pth) const
+    {
+      return basic_clon_view<char_t>(detail::get<char_t>(pth, view));
+    }
+
+    std::size_t total_length() const
+    {
+      return view.root->nodes.size();
+    }
+
+    // every node matching pth, "person:*.name" or "row:10-20.id", found
+    // lazily while iterating.
+    detail::matches<char_t, basic_clon_view<char_t>, basic_compiled_path<char_t>> select(
+        const std::basic_string_view<char_t> &pth) const
+    {
+      return {view, basic_compiled_path<char_t>(pth)};
+    }
+
+    detail::matches<char_t, basic_clon_view<char_t>, basic_compiled_path<char_t>> select(
+        const basic_compiled_path<char_t> &pth) const
+    {
+      return {view, pth};
+    }
+
+    template <std::size_t n>
+    detail::matches<char_t, basic_clon_view<char_t>, detail::static_path<char_t, n>> select(
+        const detail::static_path<char_t, n> &pth) const
+    {
+      return {view, pth};
+    }
+
+    // builds the child index of this list now rather than on first lookup.
+    const basic_clon_view<char_t> &index() const
+    {
+      if (view.type() == clon_type::list)
+      {
+        if (view.root->frozen and not view.root->indexes.contains(view.index))
+          detail::handle_frozen();
+
+        detail::index_of(*view.root, view.index);
+      }
+
+      return *this;
+    }
+
+    detail::memory_report memory() const
+    {
+      return detail::memory_of(*view.root);
+    }
+
+    clon_type type() const
+    {
+      switch (view.type())
+      {
+      case clon_type::boolean:
+      case clon_type::no_boolean:
+        return clon_type::boolean;
+      case clon_type::number:
+      case clon_type::no_number:
+        return clon_type::number;
+      case clon_type::string:
+      case clon_type::no_string:
+        return clon_type::string;
+      case clon_type::real:
+      case clon_type::no_real:
+        return clon_type::real;
+      case clon_type::list:
+        return clon_type::list;
+      case clon_type::none:
+      default:
+        return clon_type::none;
+      }
+    }
+
+    const std::basic_string_view<char_t> &name() const
+    {
+      return view.name();
+    }
+
+    template <typename type_t>
+    const type_t &as_() const
+    {
+      return view.template as_<type_t>();
+    }
+
+    template <typename type_t>
+    const type_t &get_(
+        const std::basic_string_view<char_t> &pth) const
+    {
+      return (*this)[pth].template as_<type_t>();
+    }
+
+    const clon::string<char_t> &string(
+        const std::basic_string_view<char_t> &pth)
+    {
+      return get_<clon::string<char_t>>(pth);
+    }
+
+    const clon::number &number(
+        const std::basic_string_view<char_t> &pth)
+    {
+      return get_<clon::number>(pth);
+    }
+
+    const clon::real &real(
+        const std::basic_string_view<char_t> &pth)
+    {
+      return get_<clon::real>(pth);
+    }
+
+    const clon::boolean &boolean(const std::basic_string_view<char_t> &pth)
+    {
+      return get_<clon::boolean>(pth);
+    }
+
+    const std::basic_string<char_t> to_string()
+    {
+      return view.to_string();
+    }
+
+    // the view back as clon text, compact or pretty, through the writer :
+    // write_into fills write_length chars from out and returns their end,
+    // write_to streams the text through a formatter context. write_binary
+    // gives the binary layout instead, see basic_binary_clon.
+    std::size_t write_length(
+        const write_mode &mode = write_mode::compact) const
+    {
+      return detail::write_length(view, mode);
+    }
+
+    char_t *write_into(
+        char_t *out,
+        const write_mode &mode = write_mode::compact) const
+    {
+      return detail::write_clon(out, view, mode);
+    }
+
+    std::basic_string<char_t> write(
+        const write_mode &mode = write_mode::compact) const
+    {
+      return detail::write_clon<char_t>(view, mode);
+    }
+
+    void write_to(
+        fmt::formatter_context<char_t> &ctx,
+        const write_mode &mode = write_mode::compact) const
+    {
+      detail::write_clon(ctx, view, mode);
+    }
+
+    std::basic_string<char_t> write_binary(
+        const binary_options &opts = {}) const
+    {
+      return detail::write_binary<char_t>(view, opts);
+    }
+
+    const std::basic_string_view<char_t>& value()
+    {
+      return view.valv();
+    }
+
+    template <typename type_t>
+    void update(const std::basic_string_view<char_t> &valv)
+    {
+      if (view.root->frozen)
+        detail::handle_frozen();
+
+      if (view.index != detail::no_root)
+      {
+        detail::node<char> &node = view.root->nodes[view.index];
+        node.valv = detail::store(*view.root, valv);
+
+        if constexpr (std::is_same_v<type_t, detail::boolean>)
+          node.val = detail::no_boolean{};
+
+        if constexpr (std::is_same_v<type_t, detail::string<char_t>>)
+          node.val = detail::no_string{};
+
+        if constexpr (std::is_same_v<type_t, detail::number>)
+          node.val = detail::no_number{};
+
+        if constexpr (std::is_same_v<type_t, detail::real>)
+          node.val = detail::no_real{};
+      }
+    }
+
+    friend std::size_t length_of(
+        const basic_clon_view<char_t> &a)
+    {
+      return detail::length_of(a.view);
+    }
+
+    friend void format_of(
+        clon::fmt::formatter_context<char_t> &ctx,
+        const basic_clon_view<char_t> &a)
+    {
+      detail::format_of(ctx, a.view);
+    }
+  };
+
+  template <typename char_t>
+  class basic_clon_stream;
+
+  template <typename char_t>
+  class basic_parser;
+
+  template <typename char_t>
+  class basic_clon
+      : public basic_clon_view<char_t>
+  {
+    std::unique_ptr<detail::root_node<char_t>> node;
+
+    friend class basic_clon_stream<char_t>;
+    friend class basic_parser<char_t>;
+
+    explicit basic_clon(std::unique_ptr<detail::root_node<char_t>> &&_n)
+        : basic_clon_view<char_t>(detail::make_rview(*_n)), node(std::move(_n)) {}
+
+  public:
+    // borrows _v : no copy is made, every name and value views the
+    // caller's buffer which must outlive the clon and stay unchanged.
+    explicit basic_clon(
+        const std::basic_string_view<char_t> &_v,
+        const basic_parse_options<char_t> &opts = {})
+        : basic_clon(detail::parse_root(detail::make_root(_v, opts.resource), opts)) {}
+
+    template <std::size_t n>
+    explicit basic_clon(
+        const char_t (&_s)[n],
+        const basic_parse_options<char_t> &opts = {})
+        : basic_clon(std::basic_string_view<char_t>(_s, n - 1), opts) {}
+
+    // owns _s : the buffer is moved in and every view points into it.
+    explicit basic_clon(
+        std::basic_string<char_t> &&_s,
+        const basic_parse_options<char_t> &opts = {})
+        : basic_clon(detail::parse_root(detail::make_root(std::move(_s), opts.resource), opts)) {}
+
+    explicit basic_clon(
+        std::vector<char_t> &&_v,
+        const basic_parse_options<char_t> &opts = {})
+        : basic_clon(detail::parse_root(detail::make_root(std::move(_v), opts.resource), opts)) {}
+
+    // parses every top level document of _v on up to threads threads and
+    // returns them in input order. like the borrowing constructor, _v must
+    // outlive the results. the first failing document's error is rethrown.
+    // the names are interned once every document is parsed, in input
+    // order, by the calling thread. opts.resource is used by all the
+    // threads at once so it must be thread safe, as the default one is.
+    static std::vector<basic_clon> parse_many(
+        const std::basic_string_view<char_t> &_v,
+        std::size_t threads = std::thread::hardware_concurrency(),
+        const basic_parse_options<char_t> &opts = {})
+    {
+      const std::vector<std::basic_string_view<char_t>> docs = detail::split_documents(_v);
+      std::vector<std::unique_ptr<detail::root_node<char_t>>> roots(docs.size());
+      std::vector<std::exception_ptr> errors(docs.size());
+      std::atomic<std::size_t> next = 0;
+      basic_parse_options<char_t> unnamed = opts;
+      unnamed.names = nullptr;
+
+      auto &&work = [&] {
+        for (std::size_t i = next++; i < docs.size(); i = next++)
+          try
+          {
+            roots[i] = detail::parse_root(detail::make_root(docs[i], opts.resource), unnamed);
+          }
+          catch (...)
+          {
+            errors[i] = std::current_exception();
+          }
+      };
+
+      std::vector<std::thread> pool;
+      threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(docs.size(), 1));
+
+      for (std::size_t t = 1; t < threads; ++t)
+        pool.emplace_back(work);
+
+      work();
+
+      for (std::thread &worker : pool)
+        worker.join();
+
+      for (const std::exception_ptr &error : errors)
+        if (error)
+          std::rethrow_exception(error);
+
+      if (opts.names != nullptr)
+        for (auto &&root : roots)
+        {
+          root->names = opts.names;
+          detail::intern_names(*root);
+        }
+
+      std::vector<basic_clon> clons;
+      clons.reserve(roots.size());
+
+      for (auto &&root : roots)
+        clons.push_back(basic_clon(std::move(root)));
+
+      return clons;
+    }
 
-    splits_iterator &operator++()
+    // once frozen the document is read only : every value is decoded and
+    // every index built, so any number of threads may read it, through
+    // views, paths or select, without locking. update then throws.
+    const basic_clon &freeze()
     {
-      if (data.size() != 0)
-      {
-        auto found = std::find(data.begin(), data.end(), del);
-        data = std::basic_string_view<char_t>(
-            found == data.end() ? found : found + 1, data.end());
-      }
-
+      detail::freeze(*node);
       return *this;
     }
 
-    const std::basic_string_view<char_t> operator*()
+    bool frozen() const
     {
-      return std::basic_string_view<char_t>(
-          data.begin(), std::find(data.begin(), data.end(), del));
+      return node->frozen;
     }
 
-    splits_iterator operator++(int)
+    // maps the file read-only : views point straight into the mapping
+    // which lives as long as the clon.
+    static basic_clon from_file(
+        const std::string &path,
+        const basic_parse_options<char_t> &opts = {})
     {
-      splits_iterator tmp(*this);
-      ++(*this);
-      return tmp;
+      return basic_clon(detail::parse_root(
+          detail::make_root(detail::mapped_file<char_t>(path), opts.resource), opts));
     }
+  };
 
-    friend bool operator==(
-        const splits_iterator &a,
-        const splits_iterator &b)
+  template <typename char_t>
+  class basic_clon_stream
+  {
+    detail::stream_parser<char_t> parser;
+
+  public:
+    // chunks may end anywhere, even inside a name, a string or a number :
+    // only the names and values are kept, never the chunk itself.
+    void feed(const std::basic_string_view<char_t> &chunk)
     {
-      return a.data.data() == b.data.data();
+      parser.feed(chunk);
     }
 
-    friend bool operator!=(
-        const splits_iterator &a,
-        const splits_iterator &b)
+    basic_clon<char_t> finish()
     {
-      return not(a == b);
+      auto &&root = std::make_unique<detail::root_node<char_t>>();
+      parser.finish(*root);
+      return basic_clon<char_t>(std::move(root));
     }
   };
 
+  // parses documents one after the other with the same options. parse_into
+  // reuses the nodes, name ids and arena of a document already parsed, so
+  // once they are large enough a document parses without any allocation.
   template <typename char_t>
-  struct splits
+  class basic_parser
   {
-    char_t del;
-    std::basic_string_view<char_t> data;
+    basic_parse_options<char_t> opts;
+
+  public:
+    explicit basic_parser(
+        const basic_parse_options<char_t> &_opts = {})
+        : opts(_opts) {}
 
-    splits_iterator<char_t> begin() const
+  public:
+    basic_clon<char_t> parse(
+        const std::basic_string_view<char_t> &data) const
     {
-      return splits_iterator<char_t>{del, data};
+      return basic_clon<char_t>(data, opts);
     }
 
-    splits_iterator<char_t> end() const
+    // doc borrows data from now on, like the borrowing constructor. when
+    // data does not parse, doc is left without nodes until parsed again.
+    void parse_into(
+        basic_clon<char_t> &doc,
+        const std::basic_string_view<char_t> &data) const
     {
-      return splits_iterator<char_t>{del, data.substr(data.size())};
+      detail::reset_root(*doc.node, data);
+      detail::configure(*doc.node, opts);
+      detail::parse(*doc.node);
     }
   };
 
   template <typename char_t>
-  splits<char_t> split(
-      const std::basic_string_view<char_t> &data,
-      const char_t &del)
+  class basic_compact_view
   {
-    return splits<char_t>{del, data};
-  }
+    detail::tape_view<char_t> view;
 
-  template <typename char_t>
-  struct paths_iterator
-  {
-    splits_iterator<char_t> sit;
+  public:
+    explicit basic_compact_view(
+        const detail::tape_view<char_t> &_v)
+        : view(_v) {}
 
-    paths_iterator &operator++()
+  public:
+    basic_compact_view<char_t> operator[](
+        const std::basic_string_view<char_t> &pth) const
     {
-      ++sit;
-      return *this;
+      return basic_compact_view<char_t>(detail::get<char_t>(detail::split_paths(pth), view));
     }
 
-    paths_iterator operator++(int)
+    basic_compact_view<char_t> operator[](
+        const basic_compiled_path<char_t> &pth) const
     {
-      paths_iterator tmp(*this);
-      ++(*this);
-      return tmp;
+      return basic_compact_view<char_t>(detail::get<char_t>(pth, view));
     }
 
-    path<char_t> operator*()
+    template <std::size_t n>
+    basic_compact_view<char_t> operator[](
+        const detail::static_path<char_t, n> &pth) const
     {
-      return parse_path(*sit);
+      return basic_compact_view<char_t>(detail::get<char_t>(pth, view));
     }
 
-    friend bool operator==(
-        const paths_iterator &a,
-        const paths_iterator &b)
+    std::size_t total_length() const
     {
-      return a.sit == b.sit;
+      return view.root->types.size();
     }
 
-    friend bool operator!=(
-        const paths_iterator &a,
-        const paths_iterator &b)
+    clon_type type() const
     {
-      return not(a == b);
+      switch (view.type())
+      {
+      case clon_type::no_boolean:
+        return clon_type::boolean;
+      case clon_type::no_number:
+        return clon_type::number;
+      case clon_type::no_string:
+        return clon_type::string;
+      case clon_type::no_real:
+        return clon_type::real;
+      default:
+        return view.type();
+      }
     }
-  };
-
-  template <typename char_t>
-  struct paths
-  {
-    splits<char_t> spl;
 
-    paths_iterator<char_t> begin() const { return {spl.begin()}; }
-    paths_iterator<char_t> end() const { return {spl.end()}; }
-  };
+    std::basic_string_view<char_t> name() const
+    {
+      return view.name();
+    }
 
-  template <typename char_t>
-  paths<char_t> split_paths(const std::basic_string_view<char_t> &pths)
-  {
-    return paths<char_t>{split(pths, '.')};
-  }
+    std::basic_string_view<char_t> value() const
+    {
+      return view.valv();
+    }
 
-  template <typename char_t>
-  root_view<char_t> getone(
-      const path<char_t> &pth,
-      const root_view<char_t> &view)
-  {
-    std::size_t cnt = 0;
+    template <typename type_t>
+    type_t as_() const
+    {
+      return view.template as_<type_t>();
+    }
 
-    if (view.type() == clon_type::list)
-      for (root_view<char_t> &&child : childs(view))
-        if (child.name() == pth.name)
-        {
-          if (cnt == pth.min)
-            return child;
-          else
-            ++cnt;
-        }
+    detail::memory_report memory() const
+    {
+      return detail::memory_of(*view.root);
+    }
 
-    return make_rview(view, no_root);
-  }
+    // same writer as basic_clon_view::write.
+    std::size_t write_length(
+        const write_mode &mode = write_mode::compact) const
+    {
+      return detail::write_length(view, mode);
+    }
 
-  template <typename char_t>
-  root_view<char_t> getone(
-      const std::basic_string_view<char_t> &pth,
-      const root_view<char_t> &view)
-  {
-    return getone(parse_path(pth), view);
-  }
+    char_t *write_into(
+        char_t *out,
+        const write_mode &mode = write_mode::compact) const
+    {
+      return detail::write_clon(out, view, mode);
+    }
 
-  template <typename char_t>
-  root_view<char_t> get(
-      const std::basic_string_view<char_t> &pths,
-      const root_view<char_t> &view)
-  {
-    bool should_return = false;
+    std::basic_string<char_t> write(
+        const write_mode &mode = write_mode::compact) const
+    {
+      return detail::write_clon<char_t>(view, mode);
+    }
 
-    root_view<char_t> vfound = view;
+    void write_to(
+        fmt::formatter_context<char_t> &ctx,
+        const write_mode &mode = write_mode::compact) const
+    {
+      detail::write_clon(ctx, view, mode);
+    }
 
-    for (const path<char_t> &pth : split_paths(pths))
+    std::basic_string<char_t> write_binary(
+        const binary_options &opts = {}) const
     {
-      bool found = false;
+      return detail::write_binary<char_t>(view, opts);
+    }
 
-      if (should_return)
-        return make_rview(view, no_root);
+    friend std::size_t length_of(
+        const basic_compact_view<char_t> &a)
+    {
+      return detail::view_of(a.view.root->buff).size();
+    }
 
-      if (vfound.template is_<list>())
-      {
-        std::size_t cnt = 0;
+    friend void format_of(
+        clon::fmt::formatter_context<char_t> &ctx,
+        const basic_compact_view<char_t> &a)
+    {
+      detail::format_of(ctx, a.view);
+    }
+  };
 
-        for (root_view<char_t> &&child : childs(vfound))
-          if (child.name() == pth.name)
-          {
-            if (cnt == pth.min)
-            {
-              found = true;
-              vfound = child;
-              break;
-            }
-            else
-              ++cnt;
-          }
-      }
-      else
-        should_return = true;
+  // read only document in the compact layout : smaller and faster to walk
+  // than basic_clon, but values are decoded on every access. nothing is
+  // written after parsing so threads may share it without freezing.
+  template <typename char_t>
+  class basic_compact_clon
+      : public basic_compact_view<char_t>
+  {
+    std::unique_ptr<detail::tape<char_t>> tape;
 
-      if (not found)
-        return make_rview(view, no_root);
+    explicit basic_compact_clon(
+        std::unique_ptr<detail::tape<char_t>> &&_t,
+        const basic_parse_options<char_t> &opts)
+        : basic_compact_view<char_t>(detail::tape_view<char_t>{_t.get(), 0}), tape(std::move(_t))
+    {
+      tape->eager_values = opts.eager_values;
+      tape->max_depth = opts.max_depth;
+      detail::parse(*tape);
     }
 
-    return vfound;
-  }
-}
+    static std::unique_ptr<detail::tape<char_t>> make_tape(detail::source<char_t> &&src)
+    {
+      auto tp = std::make_unique<detail::tape<char_t>>();
+      tp->buff = std::move(src);
+      return tp;
+    }
 
-namespace clon
-{
-  using clon_type = detail::clon_type;
-  using number = detail::number;
-  template <typename char_t>
-  using string = detail::string<char_t>;
-  using list = detail::list;
-  using boolean = detail::boolean;
+  public:
+    // only eager_values and max_depth apply to the compact layout.
+    explicit basic_compact_clon(
+        const std::basic_string_view<char_t> &_v,
+        const basic_parse_options<char_t> &opts = {})
+        : basic_compact_clon(make_tape(_v), opts) {}
+
+    template <std::size_t n>
+    explicit basic_compact_clon(
+        const char_t (&_s)[n],
+        const basic_parse_options<char_t> &opts = {})
+        : basic_compact_clon(std::basic_string_view<char_t>(_s, n - 1), opts) {}
+
+    explicit basic_compact_clon(
+        std::basic_string<char_t> &&_s,
+        const basic_parse_options<char_t> &opts = {})
+        : basic_compact_clon(make_tape(std::move(_s)), opts) {}
+
+    static basic_compact_clon from_file(
+        const std::string &path,
+        const basic_parse_options<char_t> &opts = {})
+    {
+      return basic_compact_clon(make_tape(detail::mapped_file<char_t>(path)), opts);
+    }
+  };
 
   template <typename char_t>
-  class basic_clon_view
+  class basic_binary_view
   {
-    detail::root_view<char_t> view;
+    detail::binary_view<char_t> view;
 
   public:
-    explicit basic_clon_view(
-        const detail::root_view<char_t> &_v)
+    explicit basic_binary_view(
+        const detail::binary_view<char_t> &_v)
         : view(_v) {}
 
   public:
-    basic_clon_view<char_t> operator[](
+    basic_binary_view<char_t> operator[](
         const std::basic_string_view<char_t> &pth) const
     {
-      return basic_clon_view<char_t>(detail::get(pth, view));
+      return basic_binary_view<char_t>(detail::get<char_t>(detail::split_paths(pth), view));
     }
 
-    std::size_t total_length() const
+    basic_binary_view<char_t> operator[](
+        const basic_compiled_path<char_t> &pth) const
     {
-      return view.root->nodes.size();
+      return basic_binary_view<char_t>(detail::get<char_t>(pth, view));
+    }
+
+    template <std::size_t n>
+    basic_binary_view<char_t> operator[](
+        const detail::static_path<char_t, n> &pth) const
+    {
+      return basic_binary_view<char_t>(detail::get<char_t>(pth, view));
     }
 
     clon_type type() const
     {
-      switch (view.type())
-      {
-      case clon_type::boolean:
-      case clon_type::no_boolean:
-        return clon_type::boolean;
-      case clon_type::number:
-      case clon_type::no_number:
-        return clon_type::number;
-      case clon_type::string:
-      case clon_type::no_string:
-        return clon_type::string;
-      case clon_type::list:
-        return clon_type::list;
-      case clon_type::none:
-      default:
-        return clon_type::none;
-      }
+      return view.type();
     }
 
-    const std::basic_string_view<char_t> &name() const
+    std::basic_string_view<char_t> name() const
     {
       return view.name();
     }
 
-    template <typename type_t>
-    const type_t &as_() const
+    // a string in place, any other value printed.
+    std::basic_string<char_t> value() const
     {
-      return view.template as_<type_t>();
+      return std::basic_string<char_t>(std::basic_string_view<char_t>(view.valv()));
     }
 
     template <typename type_t>
-    const type_t &get_(
-        const std::basic_string_view<char_t> &pth) const
+    type_t as_() const
     {
-      return (*this)[pth].template as_<type_t>();
+      return view.template as_<type_t>();
     }
 
-    const clon::string<char_t> &string(
-        const std::basic_string_view<char_t> &pth)
+    detail::memory_report memory() const
     {
-      return get_<clon::string<char_t>>(pth);
+      return detail::memory_of(*view.root);
     }
 
-    const clon::number &number(
-        const std::basic_string_view<char_t> &pth)
+    // same writers as basic_clon_view.
+    std::size_t write_length(
+        const write_mode &mode = write_mode::compact) const
     {
-      return get_<clon::number>(pth);
+      return detail::write_length(view, mode);
     }
 
-    const clon::boolean &boolean(const std::basic_string_view<char_t> &pth)
+    char_t *write_into(
+        char_t *out,
+        const write_mode &mode = write_mode::compact) const
     {
-      return get_<clon::boolean>(pth);
+      return detail::write_clon(out, view, mode);
     }
 
-    const std::basic_string<char_t> to_string()
+    std::basic_string<char_t> write(
+        const write_mode &mode = write_mode::compact) const
     {
-      return view.to_string();
+      return detail::write_clon<char_t>(view, mode);
     }
 
-    const std::basic_string_view<char_t>& value()
+    void write_to(
+        fmt::formatter_context<char_t> &ctx,
+        const write_mode &mode = write_mode::compact) const
     {
-      return view.valv();
+      detail::write_clon(ctx, view, mode);
     }
 
-    template <typename type_t>
-    void update(const std::basic_string_view<char_t> &valv)
+    std::basic_string<char_t> write_binary(
+        const binary_options &opts = {}) const
     {
-      if (view.index != detail::no_root)
-      {
-        view.root->updt.push_back(
-            std::basic_string<char_t>(valv.begin(), valv.end()));
-
-        detail::node<char> &node = view.root->nodes[view.index];
-
-        node.valv = std::basic_string_view<char_t>(
-            view.root->updt.back().begin(),
-            view.root->updt.back().end());
-
-        if constexpr (std::is_same_v<type_t, detail::boolean>)
-          node.val = detail::no_boolean{};
-
-        if constexpr (std::is_same_v<type_t, detail::string<char_t>>)
-          node.val = detail::no_string{};
-
-        if constexpr (std::is_same_v<type_t, detail::number>)
-          node.val = detail::no_number{};
-      }
+      return detail::write_binary<char_t>(view, opts);
     }
 
     friend std::size_t length_of(
-        const basic_clon_view<char_t> &a)
+        const basic_binary_view<char_t> &a)
     {
-      return detail::length_of(a.view);
+      return a.write_length();
     }
 
     friend void format_of(
         clon::fmt::formatter_context<char_t> &ctx,
-        const basic_clon_view<char_t> &a)
+        const basic_binary_view<char_t> &a)
     {
       detail::format_of(ctx, a.view);
     }
   };
 
+  // read only document in the binary layout written by write_binary :
+  // loading only checks every node once, then queries read the layout in
+  // place without building any node. only max_depth applies.
   template <typename char_t>
-  class basic_clon
-      : public basic_clon_view<char_t>
+  class basic_binary_clon
+      : public basic_binary_view<char_t>
   {
-    detail::root_node<char_t> node;
+    std::unique_ptr<detail::binary<char_t>> bin;
+
+    explicit basic_binary_clon(
+        std::unique_ptr<detail::binary<char_t>> &&_b,
+        const basic_parse_options<char_t> &opts)
+        : basic_binary_view<char_t>(detail::binary_view<char_t>{_b.get(), detail::no_root}), bin(std::move(_b))
+    {
+      bin->max_depth = opts.max_depth;
+      detail::load(*bin);
+      static_cast<basic_binary_view<char_t> &>(*this) =
+          basic_binary_view<char_t>(detail::binary_view<char_t>{bin.get(), bin->first});
+    }
+
+    static std::unique_ptr<detail::binary<char_t>> make_binary(detail::source<char_t> &&src)
+    {
+      auto bn = std::make_unique<detail::binary<char_t>>();
+      bn->buff = std::move(src);
+      return bn;
+    }
 
   public:
-    explicit basic_clon(const std::basic_string_view<char_t> &_v)
-        : basic_clon_view<char_t>(detail::make_rview(node)), node(detail::parse(_v)) {}
+    explicit basic_binary_clon(
+        const std::basic_string_view<char_t> &_v,
+        const basic_parse_options<char_t> &opts = {})
+        : basic_binary_clon(make_binary(_v), opts) {}
+
+    explicit basic_binary_clon(
+        std::basic_string<char_t> &&_s,
+        const basic_parse_options<char_t> &opts = {})
+        : basic_binary_clon(make_binary(std::move(_s)), opts) {}
+
+    static basic_binary_clon from_file(
+        const std::string &path,
+        const basic_parse_options<char_t> &opts = {})
+    {
+      return basic_binary_clon(make_binary(detail::mapped_file<char_t>(path)), opts);
+    }
   };
 
+  // drives visitor through the document without building any node :
+  // on_open(name), then on_boolean, on_number (integer or real, see
+  // detail::is_real) or on_string with the raw value (nothing for a list
+  // or an empty node), and on_close.
+  template <typename char_t, typename visitor_t>
+  requires detail::clon_visitor<visitor_t, char_t>
+  void parse_events(
+      const std::basic_string_view<char_t> &data,
+      visitor_t &visitor,
+      const std::size_t &max_depth = detail::default_max_depth)
+  {
+    detail::parse_events(data, visitor, max_depth);
+  }
+
+  inline namespace literals
+  {
+    // "person:1.name"_path is split and checked at compile time.
+    template <detail::fixed_path pths>
+    consteval auto operator""_path()
+    {
+      return detail::make_static_path<pths>();
+    }
+  }
+
   using clon = basic_clon<char>;
   using wclon = basic_clon<wchar_t>;
+  using clon_stream = basic_clon_stream<char>;
+  using compact_clon = basic_compact_clon<char>;
+  using wcompact_clon = basic_compact_clon<wchar_t>;
+  using binary_clon = basic_binary_clon<char>;
+  using wbinary_clon = basic_binary_clon<wchar_t>;
+  using wclon_stream = basic_clon_stream<wchar_t>;
+  using parser = basic_parser<char>;
+  using wparser = basic_parser<wchar_t>;
 }
 
 #endif
\ No newline at end of file
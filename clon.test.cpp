@@ -1,4 +1,9 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <thread>
+#include <atomic>
 #include "clon.hpp"
 #include "test.hpp"
 
@@ -90,6 +95,613 @@ void should_update_to_Paulo()
   test_equals(a.string("person.firstname"), "Paulo");
 }
 
+void should_find_same_structurals()
+{
+  namespace detail = clon::detail;
+  std::string big;
+
+  for (int i = 0; i < 20; ++i)
+    big += str;
+
+  std::vector<std::size_t> scalar, sse2, avx2;
+  detail::find_structurals(std::string_view(big), scalar, detail::simd_level::scalar);
+  detail::find_structurals(std::string_view(big), sse2, detail::simd_level::sse2);
+  detail::find_structurals(std::string_view(big), avx2, detail::best_simd_level);
+
+  test_equals(scalar.size(), 1 + 20 * 102);
+  test_equals(scalar == sse2, true);
+  test_equals(scalar == avx2, true);
+  test_equals(big[scalar[0]], '(');
+  test_equals(big[scalar[1]], 'b');
+}
+
+void should_catch_unterminated_string()
+{
+  test_catch(clon::clon(std::string_view("(a \"b)")), std::runtime_error);
+}
+
+void should_borrow_without_copy()
+{
+  clon::clon a(str);
+  test_equals(a.name().data(), str.data() + 2);
+  test_equals(a["person.firstname"].value().data() >= str.data(), true);
+  test_equals(a["person.firstname"].value().data() < str.data() + str.size(), true);
+}
+
+void should_own_moved_buffer()
+{
+  auto &&make = [] {
+    std::string s(str);
+    return clon::clon(std::move(s));
+  };
+
+  clon::clon a = make();
+  test_equals(a.string("person:1.address.city"), "London");
+
+  clon::clon b(std::vector<char>(str.begin(), str.end()));
+  clon::clon c = std::move(b);
+  test_equals(c.number("person.address.postal"), 82910);
+
+  clon::clon d("(a (b 12))");
+  test_equals(d.number("b"), 12);
+
+  clon::clon e(std::string("(r (a 7))"));
+  clon::clon f = std::move(e);
+  test_equals(f.number("a"), 7);
+}
+
+void should_load_from_file()
+{
+  const char *path = "clon.test.tmp";
+  std::ofstream(path) << str;
+
+  {
+    clon::clon a = clon::clon::from_file(path);
+    test_equals(a.name(), "bdd");
+    test_equals(a.string("person:1.name"), "Londubass");
+    test_equals(a.total_length(), 24);
+  }
+
+  std::remove(path);
+  test_catch(clon::clon::from_file(path), std::runtime_error);
+}
+
+void should_stream_in_chunks()
+{
+  const clon::clon a(str);
+  const std::string expected = clon::fmt::format("{}", a);
+
+  for (std::size_t size = 1; size < 8; ++size)
+  {
+    clon::clon_stream stream;
+    std::string_view rest = str;
+
+    while (not rest.empty())
+    {
+      stream.feed(rest.substr(0, size));
+      rest.remove_prefix(std::min(size, rest.size()));
+    }
+
+    clon::clon b = stream.finish();
+    test_equals(clon::fmt::format("{}", b), expected);
+    test_equals(b.string("person:1.name"), "Londubass");
+  }
+
+  clon::clon_stream stream;
+  stream.feed("(root (a \"unfinished");
+  test_catch(stream.finish(), std::runtime_error);
+}
+
+struct event_recorder
+{
+  std::string events;
+
+  void on_open(std::string_view name) { events += clon::fmt::format("({}", name); }
+  void on_boolean(std::string_view v) { events += clon::fmt::format(" b:{}", v); }
+  void on_number(std::string_view v) { events += clon::fmt::format(" n:{}", v); }
+  void on_string(std::string_view v) { events += clon::fmt::format(" s:{}", v); }
+  void on_close() { events += ")"; }
+};
+
+void should_emit_events()
+{
+  event_recorder rec;
+  clon::parse_events(std::string_view("(a (b 12) (c \"x y\") (d (e true)) (f))"), rec);
+  test_equals(rec.events, "(a(b n:12)(c s:x y)(d(e b:true))(f))");
+
+  event_recorder bad;
+  test_catch(clon::parse_events(std::string_view("(a (b 12)"), bad), std::runtime_error);
+}
+
+void should_lookup_compiled_path()
+{
+  using namespace clon::literals;
+  clon::clon a(str);
+  const clon::compiled_path name("person:1.name");
+  const clon::compiled_path copy = name;
+
+  test_equals(a[name].value(), "Londubass");
+  test_equals(a[copy].value(), "Londubass");
+  test_equals(a["person:1.name"_path].value(), "Londubass");
+  test_equals(a["person.address.postal"_path].value(), "82910");
+  test_equals(a[clon::compiled_path("person:2.name")].type(), clon::clon_type::none);
+  test_catch(clon::compiled_path("person.9"), std::runtime_error);
+}
+
+void should_intern_names()
+{
+  clon::name_table names;
+  clon::clon a(str, {&names});
+  const std::uint32_t person = names.find("person");
+  const std::size_t interned = names.size();
+  clon::clon b(std::string_view("(bdd (person (name \"Solo\")))"), {&names});
+  clon::compiled_path name("person:1.name");
+  name.bind(names);
+
+  test_equals(names.find("person"), person);
+  test_equals(names.size(), interned);
+  test_equals(names.find("firstname") != person, true);
+  test_equals(names.find("firstname") != names.find("name"), true);
+  test_equals(names.name(names.find("postal")), "postal");
+  test_equals(names.find("unknown"), clon::detail::no_name);
+  test_equals(a[name].value(), "Londubass");
+  test_equals(b[name].type(), clon::clon_type::none);
+  test_equals(b[clon::compiled_path("person.name").bind(names)].value(), "Solo");
+}
+
+void should_index_children()
+{
+  std::string rows = "(rows ";
+
+  for (std::size_t i = 0; i < 100; ++i)
+    rows += clon::fmt::format("(row (id {})) (sep true) ", i);
+
+  rows += ")";
+
+  clon::clon a(std::string_view(rows), {.index_lists = true});
+  const clon::memory_report before = a.memory();
+  test_equals(before.indexes, 0);
+  test_equals(a["row:42.id"].value(), "42");
+  test_equals(a["sep:99"].value(), "true");
+  test_equals(a["row:100.id"].type(), clon::clon_type::none);
+  test_equals(a.memory().indexes > 0, true);
+  test_equals(a.memory().total() > before.total(), true);
+
+  a["row:7.id"].update<clon::number>("700");
+  test_equals(a["row:7.id"].as_<clon::number>(), 700);
+
+  clon::clon b(str);
+  b["person"].index();
+  test_equals(b.memory().indexes > 0, true);
+  test_equals(b.string("person.firstname:2"), "Henry");
+}
+
+void should_select_many()
+{
+  clon::clon a(str);
+  std::string names;
+
+  for (auto &&firstname : a.select("person:*.firstname:1-2"))
+    names += firstname.value();
+
+  test_equals(names, "JonhsonHenryMorizion");
+
+  std::size_t count = 0;
+
+  for (auto &&name : a.select(clon::compiled_path("person:0-5.name")))
+    count += name.value().size();
+
+  test_equals(count, 16);
+  test_equals(a.select("person:2-3").begin() == a.select("person:2-3").end(), true);
+  test_equals(a["person:*.name"].value(), "Morreti");
+}
+
+void should_read_compact_layout()
+{
+  using namespace clon::literals;
+  clon::clon a(str);
+  clon::compact_clon c(str);
+
+  test_equals(clon::fmt::format("{}", c), clon::fmt::format("{}", a));
+  test_equals(c.total_length(), a.total_length());
+  test_equals(c["person:1.name"].value(), "Londubass");
+  test_equals(c["person.address.postal"_path].as_<clon::number>(), 82910);
+  test_equals(c["person.male"].as_<clon::boolean>(), true);
+  test_equals(c["person:1.address"].type(), clon::clon_type::list);
+  test_equals(c["person:2"].type(), clon::clon_type::none);
+  test_equals(c.memory().nodes < 24 * c.total_length(), true);
+  test_catch(c["person.name"].as_<clon::number>(), std::bad_variant_access);
+}
+
+void should_decode_eagerly()
+{
+  clon::clon a(str, {.eager_values = true});
+  test_equals(a["person.age"].type(), clon::clon_type::number);
+  test_equals(a["person.address.postal"].as_<clon::number>(), 82910);
+  test_equals(a["person:1.female"].as_<clon::boolean>(), false);
+  test_equals(a.string("person:1.name"), "Londubass");
+
+  const clon::compact_clon c(str, {.eager_values = true});
+  test_equals(c["person:1.address.postal"].as_<clon::number>(), 56468);
+  test_equals(c["person.male"].as_<clon::boolean>(), true);
+
+  const clon::clon big("(n 12345678901234567)");
+  test_equals(big.as_<clon::number>(), 12345678901234567);
+}
+
+void should_parse_signed_and_real_numbers()
+{
+  clon::clon a("(account (balance -1250) (price 19.99) (rate -2.5e-3) (big 6.02E+23))");
+  test_equals(a["balance"].type(), clon::clon_type::number);
+  test_equals(a.number("balance"), -1250);
+  test_equals(a["price"].type(), clon::clon_type::real);
+  test_equals(a.real("price"), 19.99);
+  test_equals(a.real("rate"), -0.0025);
+  test_equals(a.real("big"), 6.02e23);
+
+  clon::clon limits("(l (max 9223372036854775807) (min -9223372036854775808))");
+  test_equals(limits.number("max"), std::numeric_limits<clon::number>::max());
+  test_equals(limits.number("min"), std::numeric_limits<clon::number>::min());
+
+  clon::clon over("(o (up 9223372036854775808) (down -9223372036854775809) (huge 1e400))");
+  test_catch(over.number("up"), std::runtime_error);
+  test_catch(over.number("down"), std::runtime_error);
+  test_catch(over.real("huge"), std::runtime_error);
+  test_catch(clon::clon("(o (up 99999999999999999999))", {.eager_values = true}), std::runtime_error);
+
+  test_catch(clon::clon("(o 1.)"), std::runtime_error);
+  test_catch(clon::clon("(o 1e)"), std::runtime_error);
+  test_catch(clon::clon("(o -)"), std::runtime_error);
+
+  for (const clon::real r : {0.1, -1.0 / 3.0, 6.02214076e23, 5e-324, 1500.0, -2.0})
+  {
+    clon::clon b(clon::fmt::format("(r {})", r));
+    test_equals(b.type(), clon::clon_type::real);
+    test_equals(b.as_<clon::real>(), r);
+  }
+
+  a["price"].update<clon::real>(clon::fmt::format("{}", 20.0));
+  clon::clon c(a.write());
+  test_equals(c["price"].type(), clon::clon_type::real);
+  test_equals(c.real("price"), 20.0);
+
+  a["price"].update<clon::real>("abc");
+  test_catch(a.real("price"), std::runtime_error);
+  a["price"].update<clon::real>("1.5x");
+  test_catch(a.real("price"), std::runtime_error);
+  a["price"].update<clon::real>("inf");
+  test_catch(a.real("price"), std::runtime_error);
+}
+
+void should_read_frozen_from_threads()
+{
+  std::string rows = "(rows ";
+
+  for (std::size_t i = 0; i < 200; ++i)
+    rows += clon::fmt::format("(row (id {}) (name \"n{}\") (ok true) (ratio {}.5))", i, i, i);
+
+  rows += ")";
+
+  clon::clon a(std::move(rows), {.index_lists = true});
+  a["row:0.id"].update<clon::number>("-1");
+  a.freeze();
+  test_equals(a.frozen(), true);
+
+  std::atomic<std::size_t> errors = 0;
+  std::vector<std::thread> workers;
+
+  for (std::size_t t = 0; t < 8; ++t)
+    workers.emplace_back([&a, &errors, t] {
+      for (std::size_t round = 0; round < 20; ++round)
+      {
+        clon::number sum = 0;
+
+        for (auto &&id : a.select("row:*.id"))
+          sum += id.as_<clon::number>();
+
+        const std::size_t i = (t * 37 + round * 11) % 200;
+        const clon::basic_clon_view<char> row = a[clon::fmt::format("row:{}", i)];
+
+        if (sum != 199 * 200 / 2 - 1 or
+            row["ratio"].as_<clon::real>() != i + 0.5 or
+            row["ok"].as_<clon::boolean>() != true or
+            row["name"].as_<clon::string<char>>() != clon::fmt::format("n{}", i))
+          ++errors;
+      }
+    });
+
+  for (std::thread &worker : workers)
+    worker.join();
+
+  test_equals(errors.load(), 0);
+  test_catch(a["row:1.id"].update<clon::number>("2"), std::runtime_error);
+}
+
+void should_parse_many_documents()
+{
+  std::string docs;
+
+  for (std::size_t i = 0; i < 50; ++i)
+    docs += clon::fmt::format("(doc (id {}) (text \"a ) in ( a string\"))\n", i);
+
+  for (const std::size_t threads : {1, 4})
+  {
+    std::vector<clon::clon> parsed = clon::clon::parse_many(docs, threads);
+    test_equals(parsed.size(), 50);
+    test_equals(parsed[0].number("id"), 0);
+    test_equals(parsed[49].number("id"), 49);
+    test_equals(parsed[7].string("text"), "a ) in ( a string");
+  }
+
+  std::string named;
+
+  const std::string_view letters = "abcdefghijklmnopqrstuvwxyz";
+
+  for (std::size_t i = 0; i < 4000; ++i)
+    named += clon::fmt::format("(doc (id {}) ({} {}))\n", i, letters.substr(i % 26, 1), i);
+
+  clon::name_table names;
+  std::vector<clon::clon> shared = clon::clon::parse_many(named, 4, {.names = &names});
+  clon::compiled_path z("z");
+  z.bind(names);
+  test_equals(names.size(), 28);
+  test_equals(names.name(0), "doc");
+  test_equals(names.name(3), "b");
+  test_equals(shared[25][z].as_<clon::number>(), 25);
+  test_equals(shared[3999][clon::compiled_path("id").bind(names)].as_<clon::number>(), 3999);
+
+  test_equals(clon::clon::parse_many("  \n ").size(), 0);
+  test_catch(clon::clon::parse_many("(a 1) (b (c 2)"), std::runtime_error);
+  test_catch(clon::clon::parse_many("(a 1) b (c 2)"), std::runtime_error);
+}
+
+void should_parse_in_parallel()
+{
+  std::string doc = "(root";
+
+  for (std::size_t i = 0; i < 40; ++i)
+    doc += clon::fmt::format(" (row (id {}) (text \"a ) in ( a string\") (tags (t 1) (t 2)))", i);
+
+  doc += " (last true))";
+
+  auto &&serial = clon::detail::parse(std::string_view(doc));
+  auto &&root = clon::detail::make_root(std::string_view(doc));
+  root.threads = 4;
+
+  test_equals(clon::detail::parse_parallel(root, std::string_view(doc)), true);
+  test_equals(root.nodes.size(), serial.nodes.size());
+
+  for (std::size_t i = 0; i < root.nodes.size(); ++i)
+    test_equals(
+        root.nodes[i].name.data() == serial.nodes[i].name.data() and
+            root.nodes[i].valv.data() == serial.nodes[i].valv.data() and
+            root.nodes[i].val.index() == serial.nodes[i].val.index() and
+            root.nodes[i].next == serial.nodes[i].next and
+            root.nodes[i].child == serial.nodes[i].child,
+        true);
+
+  std::string big = "(root";
+
+  while (big.size() < 2 * clon::detail::parallel_threshold)
+    big += clon::fmt::format(" (row (id {}) (text \"a ) in ( a string\"))", big.size());
+
+  big += ")";
+
+  clon::clon one(big);
+  clon::clon many(big, {.threads = 4});
+  test_equals(clon::fmt::format("{}", many), clon::fmt::format("{}", one));
+  test_equals(many.number("row:2.id"), one.number("row:2.id"));
+
+  big[big.find("(row", big.size() / 2) + 1] = '#';
+  test_catch(clon::clon(big, {.threads = 4}), std::runtime_error);
+}
+
+void should_keep_updated_views()
+{
+  clon::clon a(str);
+  a["person.firstname"].update<clon::string<char>>("Pi");
+  const std::string_view first = a["person.firstname"].value();
+
+  for (std::size_t i = 0; i < 1000; ++i)
+    a["person.name"].update<clon::string<char>>(std::to_string(i));
+
+  test_equals(first, "Pi");
+  test_equals(a.string("person.name"), "999");
+
+  std::array<std::byte, 1 << 16> buffer;
+  std::pmr::monotonic_buffer_resource local(
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+  clon::clon b(str, {.resource = &local});
+  b["person.firstname"].update<clon::string<char>>("Paulo");
+  test_equals(b.string("person.firstname"), "Paulo");
+  test_equals(b.memory().updates, 5);
+
+  std::pmr::monotonic_buffer_resource tiny(
+      buffer.data(), 16, std::pmr::null_memory_resource());
+  test_catch(clon::clon(str, {.resource = &tiny}), std::bad_alloc);
+}
+
+struct counting_resource : std::pmr::memory_resource
+{
+  std::size_t allocations = 0;
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+  {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+void should_reuse_parser()
+{
+  counting_resource counting;
+  clon::parser p({.resource = &counting});
+
+  clon::clon doc = p.parse(str);
+  doc["person.firstname"].update<clon::string<char>>("Paulo");
+  const std::size_t nodes = doc.memory().nodes;
+  const std::size_t allocations = counting.allocations;
+
+  p.parse_into(doc, "(small (a 1) (b \"two\"))");
+  test_equals(doc.number("a"), 1);
+  test_equals(doc.string("b"), "two");
+  test_equals(doc.memory().nodes, nodes);
+  test_equals(doc.memory().updates, 0);
+
+  test_catch(p.parse_into(doc, "(small (a 1"), std::runtime_error);
+
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    p.parse_into(doc, str);
+    doc["person.firstname"].update<clon::string<char>>("Paulo");
+  }
+
+  test_equals(doc.string("person.firstname"), "Paulo");
+  test_equals(doc.number("person.address.postal"), 82910);
+  test_equals(counting.allocations, allocations);
+}
+
+void should_limit_depth()
+{
+  std::string deep;
+
+  for (std::size_t i = 0; i < 100000; ++i)
+    deep += "(level ";
+
+  deep += "(leaf 42)" + std::string(100000, ')');
+
+  test_catch(clon::clon(deep), std::runtime_error);
+
+  clon::clon a(deep, {.max_depth = 100001});
+  test_equals(clon::fmt::format("{}", a).size(), deep.size());
+
+  test_catch(clon::clon("(a (b (c 1)))", {.max_depth = 2}), std::runtime_error);
+  test_equals(clon::clon("(a (b (c 1)))", {.max_depth = 3}).number("b.c"), 1);
+
+  event_recorder recorder;
+  test_catch(clon::parse_events(std::string_view("(a (b 1))"), recorder, 1), std::runtime_error);
+}
+
+void should_write_clon()
+{
+  clon::clon a(str);
+  a["person.firstname"].update<clon::string<char>>("Paulo");
+
+  const std::string compact = a.write();
+  const std::string pretty = a.write(clon::write_mode::pretty);
+
+  test_equals(compact, clon::fmt::format("{}", a));
+  test_equals(compact.size(), a.write_length());
+  test_equals(pretty.size(), a.write_length(clon::write_mode::pretty));
+  test_equals(clon::clon(pretty).write(), compact);
+  test_equals(clon::clon(compact).string("person.firstname"), "Paulo");
+
+  clon::clon b("(a (b 1) (c (d \"x\")) (e))");
+  test_equals(b.write(), "(a (b 1)(c (d \"x\"))(e))");
+  test_equals(b.write(clon::write_mode::pretty), "(a\n  (b 1)\n  (c\n    (d \"x\"))\n  (e))");
+  test_equals(b["c"].write(), "(c (d \"x\"))");
+
+  std::string out(b.write_length(), '.');
+  test_equals(std::size_t(b.write_into(out.data()) - out.data()), out.size());
+  test_equals(out, b.write());
+}
+
+void should_write_to_file()
+{
+  clon::clon a(str);
+  const char *path = "clon.test.tmp";
+  std::FILE *file = std::fopen(path, "w");
+
+  {
+    clon::fmt::file_context<64> ctx(file);
+    a.write_to(ctx, clon::write_mode::pretty);
+  }
+
+  std::fclose(file);
+
+  clon::clon b = clon::clon::from_file(path);
+  test_equals(b.write(), a.write());
+  std::remove(path);
+
+  std::ostringstream os;
+  clon::fmt::format_to(os, "{}", a);
+  test_equals(os.str(), clon::fmt::format("{}", a));
+
+  std::string buff;
+  clon::fmt::formatter_context<char> ctx{buff};
+  a.write_to(ctx);
+  test_equals(buff, a.write());
+}
+
+void should_read_wide_booleans()
+{
+  const std::wstring_view text = L"(flags (on true) (off false))";
+  clon::wclon a(text);
+  test_equals(a[L"on"].as_<clon::boolean>(), true);
+  test_equals(a[L"off"].as_<clon::boolean>(), false);
+
+  clon::wclon b(a.write());
+  test_equals(b.write() == a.write(), true);
+  test_equals(b[L"on"].as_<clon::boolean>(), true);
+  test_equals(b[L"off"].as_<clon::boolean>(), false);
+
+  clon::wcompact_clon c(text);
+  test_equals(c[L"on"].as_<clon::boolean>(), true);
+  test_equals(c[L"off"].as_<clon::boolean>(), false);
+  test_equals(c.write() == a.write(), true);
+}
+
+void should_read_binary_layout()
+{
+  using namespace clon::literals;
+  const clon::clon a(str);
+  const clon::compact_clon c(str);
+
+  for (bool dictionary : {false, true})
+  {
+    const std::string bin = a.write_binary({.dictionary = dictionary});
+    const clon::binary_clon b{std::string_view(bin)};
+
+    test_equals(b.write(), a.write());
+    test_equals(clon::fmt::format("{}", b), clon::fmt::format("{}", a));
+    test_equals(b["person:1.name"].as_<clon::string<char>>(), "Londubass");
+    test_equals(b["person.address.postal"_path].as_<clon::number>(), 82910);
+    test_equals(b["person.male"].as_<clon::boolean>(), true);
+    test_equals(b["person:1.address"].type(), clon::clon_type::list);
+    test_equals(b["person:2"].type(), clon::clon_type::none);
+    test_equals(b.write_binary({.dictionary = dictionary}), bin);
+    test_equals(c.write_binary({.dictionary = dictionary}), bin);
+    test_equals(b.memory().nodes, 0);
+    test_catch(b["person.name"].as_<clon::number>(), std::bad_variant_access);
+  }
+
+  const clon::clon n("(n (min -9223372036854775808) (r 1.5e3) (s -0.25) (e))");
+  const clon::binary_clon nb(n.write_binary());
+  test_equals(nb["min"].as_<clon::number>(), std::numeric_limits<clon::number>::min());
+  test_equals(nb["r"].value(), "1500.0");
+  test_equals(clon::clon(nb.write())["r"].as_<clon::real>(), 1500.0);
+  test_equals(nb["s"].as_<clon::real>(), -0.25);
+  test_equals(nb["e"].type(), clon::clon_type::none);
+  test_equals(a["person:1"].write_binary(), clon::clon(a["person:1"].write()).write_binary());
+
+  std::string broken = n.write_binary();
+  broken.pop_back();
+  test_catch(clon::binary_clon(std::move(broken)), std::runtime_error);
+  test_catch(clon::binary_clon(std::string_view("(a 1)")), std::runtime_error);
+  test_catch(clon::binary_clon(a.write_binary(), {.max_depth = 2}), std::runtime_error);
+}
+
 int main(int argc, char **argv)
 {
   clon::clon a(str);
@@ -103,6 +715,30 @@ int main(int argc, char **argv)
   run_test(should_equals_to_false);
   run_test(should_equals_to_Paul);
   run_test(should_update_to_Paulo);
+  run_test(should_find_same_structurals);
+  run_test(should_catch_unterminated_string);
+  run_test(should_borrow_without_copy);
+  run_test(should_own_moved_buffer);
+  run_test(should_load_from_file);
+  run_test(should_stream_in_chunks);
+  run_test(should_emit_events);
+  run_test(should_lookup_compiled_path);
+  run_test(should_intern_names);
+  run_test(should_index_children);
+  run_test(should_select_many);
+  run_test(should_read_compact_layout);
+  run_test(should_decode_eagerly);
+  run_test(should_parse_signed_and_real_numbers);
+  run_test(should_read_frozen_from_threads);
+  run_test(should_parse_many_documents);
+  run_test(should_parse_in_parallel);
+  run_test(should_keep_updated_views);
+  run_test(should_reuse_parser);
+  run_test(should_limit_depth);
+  run_test(should_write_clon);
+  run_test(should_write_to_file);
+  run_test(should_read_wide_booleans);
+  run_test(should_read_binary_layout);
 
   return EXIT_SUCCESS;
 }
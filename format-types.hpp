@@ -4,12 +4,26 @@
 #include <string_view>
 #include <vector>
 #include <concepts>
+#include <charconv>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <stdexcept>
+#include <cmath>
 
 namespace clon::fmt
 {
   template <typename char_t>
   struct formatter_context;
 
+  // thrown when a pattern or a spec can not be honoured.
+  struct format_error : std::runtime_error
+  {
+    using std::runtime_error::runtime_error;
+  };
+
   template <typename char_t>
   concept charable =
       std::same_as<char_t, char> or
@@ -30,8 +44,7 @@ namespace clon::fmt
       formatter_context<char_t> &ctx,
       const std::basic_string_view<char_t> &v)
   {
-    for (const char_t &c : v)
-      ctx.append(c);
+    ctx.append(v.data(), v.size());
   }
 
   ///////////////////////////
@@ -68,46 +81,221 @@ namespace clon::fmt
   ///////////////////////////
   // integral types format //
   ///////////////////////////
+  constexpr char digit_pairs[] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+
+  constexpr char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+  constexpr std::array<char, 512> hex_pairs = [] {
+    std::array<char, 512> pairs{};
+
+    for (std::size_t i = 0; i < 256; ++i)
+    {
+      pairs[i * 2] = digits[i >> 4];
+      pairs[i * 2 + 1] = digits[i & 15];
+    }
+
+    return pairs;
+  }();
+
+  constexpr std::array<std::uint64_t, 20> powers_of_ten = [] {
+    std::array<std::uint64_t, 20> powers{1};
+
+    for (std::size_t i = 1; i < powers.size(); ++i)
+      powers[i] = powers[i - 1] * 10;
+
+    return powers;
+  }();
+
   template <std::integral integral_t>
-  std::size_t length_of(const integral_t &i)
+  constexpr bool is_negative(const integral_t &i)
+  {
+    if constexpr (std::is_signed_v<integral_t>)
+      return i < 0;
+    else
+      return false;
+  }
+
+  // |i| without overflow, even for the lowest signed value.
+  template <std::integral integral_t>
+  constexpr std::uint64_t magnitude_of(const integral_t &i)
   {
-    if (i == 0)
-      return 1;
+    const std::uint64_t u = static_cast<std::uint64_t>(i);
+    return is_negative(i) ? 0 - u : u;
+  }
 
-    constexpr unsigned base(10);
-    std::size_t len(0);
-    integral_t tmp(i);
+  // log2 from bit_width, times 1233 / 4096 gives log10 or one less,
+  // which the table of powers of ten fixes without any loop.
+  constexpr std::size_t count_digits(const std::uint64_t &u)
+  {
+    const std::uint64_t v = u | 1;
+    const std::size_t log = (std::bit_width(v) * 1233) >> 12;
+    return log + 1 - (v < powers_of_ten[log]);
+  }
 
-    while (tmp != 0)
+  constexpr std::size_t count_digits(
+      std::uint64_t u, const unsigned &base)
+  {
+    if (base == 10)
+      return count_digits(u);
+
+    if (std::has_single_bit(base))
     {
-      tmp = tmp / base;
-      len++;
+      const std::size_t shift = std::countr_zero(base);
+      return (std::bit_width(u | 1) + shift - 1) / shift;
+    }
+
+    std::size_t len = 1;
+
+    while (u >= base)
+    {
+      u /= base;
+      ++len;
     }
 
     return len;
   }
 
-  template <typename char_t, std::integral integral_t>
-  void format_of(
-      formatter_context<char_t> &ctx,
-      const integral_t &t)
+  // writes u backward from end, two decimal digits at a time, and
+  // returns where the digits begin.
+  template <typename char_t>
+  char_t *write_digits(char_t *end, std::uint64_t u)
   {
-    if (t == 0)
-      ctx.append('0');
-    else
+    while (u >= 100)
+    {
+      const std::size_t i = (u % 100) * 2;
+      u /= 100;
+      *--end = digit_pairs[i + 1];
+      *--end = digit_pairs[i];
+    }
+
+    if (u >= 10)
     {
-      integral_t tmp(t);
-      std::size_t cnt(0);
+      *--end = digit_pairs[u * 2 + 1];
+      *--end = digit_pairs[u * 2];
+    }
+    else
+      *--end = static_cast<char_t>('0' + u);
+
+    return end;
+  }
+
+  template <typename char_t>
+  char_t *write_digits(char_t *end, std::uint64_t u, const unsigned &base)
+  {
+    if (base == 10)
+      return write_digits(end, u);
 
-      while (tmp != 0)
+    if (base == 16)
+    {
+      while (u >= 256)
       {
-        ctx.append("0123456789"[tmp % 10]);
-        tmp = tmp / 10;
-        cnt++;
+        const std::size_t i = (u & 255) * 2;
+        u >>= 8;
+        *--end = hex_pairs[i + 1];
+        *--end = hex_pairs[i];
       }
 
-      std::reverse(ctx.end() - cnt, ctx.end());
+      *--end = hex_pairs[u * 2 + 1];
+
+      if (u >= 16)
+        *--end = hex_pairs[u * 2];
+
+      return end;
+    }
+
+    if (std::has_single_bit(base))
+    {
+      const unsigned shift = std::countr_zero(base);
+      const std::uint64_t mask = base - 1;
+
+      do
+      {
+        *--end = digits[u & mask];
+        u >>= shift;
+      } while (u != 0);
+
+      return end;
     }
+
+    do
+    {
+      *--end = digits[u % base];
+      u /= base;
+    } while (u != 0);
+
+    return end;
+  }
+
+  template <std::integral integral_t>
+  std::size_t length_of(const integral_t &i)
+  {
+    return count_digits(magnitude_of(i)) + is_negative(i);
+  }
+
+  template <typename char_t, std::integral integral_t>
+  void format_of(
+      formatter_context<char_t> &ctx,
+      const integral_t &t)
+  {
+    char_t buff[24];
+    char_t *end = buff + 24;
+    char_t *first = write_digits(end, magnitude_of(t));
+
+    if (is_negative(t))
+      *--first = '-';
+
+    ctx.append(first, end - first);
+  }
+
+  ///////////////////////////
+  // floating point format //
+  ///////////////////////////
+  // shortest text that reads back to the same value, and as a real :
+  // 1500.0 gives "1500.0", not "1500". nan and inf have no clon text.
+  template <std::floating_point floating_t>
+  char *real_chars(char (&buff)[64], const floating_t &f)
+  {
+    if (not std::isfinite(f))
+      throw format_error("nan and inf can not be formatted");
+
+    char *end = std::to_chars(buff, buff + sizeof(buff), f).ptr;
+
+    if (std::find_if(buff, end, [](const char &c) { return c == '.' or c == 'e'; }) == end)
+      end = std::copy_n(".0", 2, end);
+
+    return end;
+  }
+
+  template <std::floating_point floating_t>
+  std::size_t length_of(const floating_t &f)
+  {
+    char buff[64];
+    return real_chars(buff, f) - buff;
+  }
+
+  template <typename char_t, std::floating_point floating_t>
+  void format_of(
+      formatter_context<char_t> &ctx,
+      const floating_t &f)
+  {
+    char buff[64];
+    const char *end = real_chars(buff, f);
+
+    if constexpr (std::same_as<char_t, char>)
+      ctx.append(buff, end - buff);
+    else
+      for (const char *c = buff; c != end; ++c)
+        ctx.append(static_cast<char_t>(*c));
   }
 
   //////////////////////////
@@ -144,6 +332,118 @@ namespace clon::fmt
   {
     format_of(ctx, std::basic_string_view<char_t>(v.begin(), v.end()));
   }
+
+  ////////////////////////////
+  // width and base of text //
+  ////////////////////////////
+  // integers are written in base 2 to 36, then any text is right
+  // aligned on width chars by fill. a zero fill goes after the sign.
+  struct spec
+  {
+    unsigned base = 10;
+    std::size_t width = 0;
+    char fill = ' ';
+  };
+
+  // numbers are kept by value so that hex(255, 4) may be stored and
+  // formatted later, anything else is only referred to.
+  template <typename type_t>
+  struct specified
+  {
+    std::conditional_t<std::is_arithmetic_v<type_t>, type_t, const type_t &> value;
+    spec sp;
+  };
+
+  // digits[] only goes up to base 36, and base 0 or 1 has no digit.
+  inline const spec &checked(const spec &sp)
+  {
+    if (sp.base < 2 or sp.base > 36)
+      throw format_error("base must be in 2 to 36");
+
+    return sp;
+  }
+
+  template <typename type_t>
+  specified<type_t> with(const type_t &value, const spec &sp)
+  {
+    return {value, checked(sp)};
+  }
+
+  template <std::integral integral_t>
+  specified<integral_t> hex(const integral_t &value, const std::size_t &width = 0)
+  {
+    return {value, {.base = 16, .width = width, .fill = '0'}};
+  }
+
+  template <typename type_t>
+  std::size_t unpadded_length_of(const specified<type_t> &s)
+  {
+    if constexpr (std::integral<type_t>)
+      return count_digits(magnitude_of(s.value), checked(s.sp).base) + is_negative(s.value);
+    else
+      return length_of(s.value);
+  }
+
+  template <typename type_t>
+  std::size_t length_of(const specified<type_t> &s)
+  {
+    return std::max(unpadded_length_of(s), s.sp.width);
+  }
+
+  template <typename char_t>
+  void format_fill(
+      formatter_context<char_t> &ctx,
+      const spec &sp, const std::size_t &len)
+  {
+    for (std::size_t i = len; i < sp.width; ++i)
+      ctx.append(static_cast<char_t>(sp.fill));
+  }
+
+  template <typename char_t, typename type_t>
+  void format_of(
+      formatter_context<char_t> &ctx,
+      const specified<type_t> &s)
+  {
+    if constexpr (std::integral<type_t>)
+    {
+      char_t buff[65];
+      char_t *end = buff + 65;
+      char_t *first = write_digits(end, magnitude_of(s.value), checked(s.sp).base);
+      const bool negative = is_negative(s.value);
+      const std::size_t len = (end - first) + negative;
+
+      if (negative and s.sp.fill == '0')
+        ctx.append('-');
+
+      format_fill(ctx, s.sp, len);
+
+      if (negative and s.sp.fill != '0')
+        ctx.append('-');
+
+      ctx.append(first, end - first);
+    }
+    else if constexpr (std::floating_point<type_t>)
+    {
+      const bool negative = std::signbit(s.value);
+
+      if (negative and s.sp.fill == '0')
+      {
+        ctx.append('-');
+        format_fill(ctx, s.sp, length_of(s.value));
+        format_of(ctx, -s.value);
+      }
+      else
+      {
+        format_fill(ctx, s.sp, length_of(s.value));
+        format_of(ctx, s.value);
+      }
+    }
+    else
+    {
+      format_fill(ctx, s.sp, length_of(s.value));
+      format_of(ctx, s.value);
+    }
+  }
 }
 
 #endif
\ No newline at end of file
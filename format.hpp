@@ -10,6 +10,15 @@
 #include <numeric>
 #include <string_view>
 #include <tuple>
+#include <span>
+#include <stdexcept>
+#include <cstdio>
+#include <utility>
+
+#if __has_include(<unistd.h>)
+#define CLON_FMT_HAS_FD
+#include <unistd.h>
+#endif
 
 #include "format-types.hpp"
 
@@ -24,24 +33,100 @@ namespace clon::fmt
   template <typename char_t>
   using buffer = std::basic_string<char_t>;
 
+  // where formatted chars go, either appended to a growing buffer, or
+  // copied into a window [cur, last) of a fixed area. once the window
+  // is full, flush is called to empty it (fd_context) or not (a span),
+  // and what still does not fit is dropped and counted in dropped().
   template <typename char_t>
   class formatter_context
   {
+  public:
+    using flush_t = void (*)(formatter_context<char_t> &, void *);
+
   private:
-    buffer<char_t> &buff;
+    buffer<char_t> *buff = nullptr;
+    char_t *first = nullptr;
+    char_t *cur = nullptr;
+    char_t *last = nullptr;
+    void *sink = nullptr;
+    flush_t flusher = nullptr;
+    std::size_t _dropped = 0;
 
   public:
-    explicit formatter_context(buffer<char_t> &_buff) : buff(_buff) {}
+    explicit formatter_context(buffer<char_t> &_buff) : buff(&_buff) {}
+
+    explicit formatter_context(std::span<char_t> out)
+        : first(out.data()), cur(out.data()), last(out.data() + out.size()) {}
+
+    explicit formatter_context(
+        std::span<char_t> window, void *_sink, flush_t _flusher)
+        : first(window.data()), cur(window.data()),
+          last(window.data() + window.size()),
+          sink(_sink), flusher(_flusher) {}
 
   public:
     void append(const char_t &c)
     {
-      buff.push_back(c);
+      if (buff != nullptr)
+        buff->push_back(c);
+      else if (cur != last or make_room())
+        *cur++ = c;
+      else
+        ++_dropped;
+    }
+
+    void append(const char_t *s, std::size_t n)
+    {
+      if (buff != nullptr)
+      {
+        buff->append(s, n);
+        return;
+      }
+
+      while (n != 0)
+      {
+        if (cur == last and not make_room())
+        {
+          _dropped += n;
+          return;
+        }
+
+        const std::size_t len = std::min<std::size_t>(n, last - cur);
+        std::char_traits<char_t>::copy(cur, s, len);
+        cur += len;
+        s += len;
+        n -= len;
+      }
+    }
+
+    // chars of the window not flushed yet.
+    std::span<char_t> pending() const
+    {
+      return std::span<char_t>(first, cur);
+    }
+
+    // called by flush once the pending chars are gone.
+    void rewind()
+    {
+      cur = first;
     }
 
-    auto end()
+    void flush()
     {
-      return buff.end();
+      if (flusher != nullptr)
+        flusher(*this, sink);
+    }
+
+    const std::size_t &dropped() const
+    {
+      return _dropped;
+    }
+
+  private:
+    bool make_room()
+    {
+      flush();
+      return cur != last;
     }
   };
 
@@ -133,7 +218,8 @@ namespace clon::fmt
   template <typename char_t, typename... args_t>
   class partial_formatter
   {
-    constexpr static view<char_t> sep = "{}";
+    constexpr static char_t braces[] = {'{', '}'};
+    constexpr static view<char_t> sep = {braces, 2};
     pattern<char_t, sizeof...(args_t) + 1> p;
     basics<args_t...> bcs;
 
@@ -194,6 +280,129 @@ namespace clon::fmt
     return formatter<char_t, args_t...>(fmt, args...);
   }
 
+  // a literal pattern split at compile time : "{} is {}"_fmt gives a
+  // compiled_pattern whose parts are constants, so formatting with it
+  // only appends the parts and the arguments. the count of placeholders
+  // must equal the count of arguments, otherwise no overload matches.
+  template <typename char_t, std::size_t n>
+  struct literal
+  {
+    using char_type = char_t;
+    char_t data[n] = {};
+
+    constexpr literal(const char_t (&s)[n])
+    {
+      std::copy_n(s, n, data);
+    }
+
+    constexpr view<char_t> str() const
+    {
+      return view<char_t>(data, n - 1);
+    }
+  };
+
+  template <literal lit>
+  struct compiled_pattern
+  {
+    using char_type = typename decltype(lit)::char_type;
+
+    // scanned char by char : string_view::find is not a constant
+    // expression on a template parameter object once -fsanitize=undefined
+    // checks its pointers.
+    constexpr static bool is_sep(const view<char_type> &fmt, const std::size_t &i)
+    {
+      return fmt[i] == '{' and i + 1 < fmt.size() and fmt[i + 1] == '}';
+    }
+
+    constexpr static std::size_t count = [] {
+      std::size_t cnt = 0;
+      view<char_type> fmt = lit.str();
+
+      for (std::size_t i = 0; i < fmt.size(); ++i)
+        if (is_sep(fmt, i))
+        {
+          ++cnt;
+          ++i;
+        }
+
+      return cnt;
+    }();
+
+    constexpr static views<char_type, count + 1> parts = [] {
+      views<char_type, count + 1> res;
+      view<char_type> fmt = lit.str();
+      std::size_t from = 0;
+      std::size_t part = 0;
+
+      for (std::size_t i = 0; i < fmt.size(); ++i)
+        if (is_sep(fmt, i))
+        {
+          res[part++] = fmt.substr(from, i - from);
+          from = ++i + 1;
+        }
+
+      res[count] = fmt.substr(from);
+      return res;
+    }();
+
+    constexpr static std::size_t parts_size = [] {
+      std::size_t size = 0;
+
+      for (const view<char_type> &part : parts)
+        size += part.size();
+
+      return size;
+    }();
+  };
+
+  template <literal lit, typename... args_t>
+  concept compiled_for = compiled_pattern<lit>::count == sizeof...(args_t);
+
+  template <literal lit, typename... args_t>
+    requires compiled_for<lit, args_t...>
+  std::size_t predict_length_of(
+      compiled_pattern<lit>, const args_t &...args)
+  {
+    return compiled_pattern<lit>::parts_size + (length_of(args) + ... + 0);
+  }
+
+  template <literal lit, typename char_t, typename... args_t>
+    requires compiled_for<lit, args_t...> and
+             std::same_as<char_t, typename compiled_pattern<lit>::char_type>
+  void format_into(
+      formatter_context<char_t> &ctx,
+      compiled_pattern<lit>, const args_t &...args)
+  {
+    constexpr auto &parts = compiled_pattern<lit>::parts;
+    std::size_t i(0);
+
+    ((format_of(ctx, parts[i++]), format_of(ctx, args)), ...);
+    format_of(ctx, parts[i]);
+  }
+
+  template <literal lit, typename... args_t>
+    requires compiled_for<lit, args_t...>
+  buffer<typename compiled_pattern<lit>::char_type> format(
+      compiled_pattern<lit> p, const args_t &...args)
+  {
+    buffer<typename compiled_pattern<lit>::char_type> buff;
+    buff.reserve(predict_length_of(p, args...));
+
+    formatter_context ctx{buff};
+    format_into(ctx, p, args...);
+
+    return buff;
+  }
+
+  namespace literals
+  {
+    template <literal lit>
+    consteval compiled_pattern<lit> operator""_fmt()
+    {
+      return {};
+    }
+  }
+
   template <typename char_t>
   std::basic_string<char_t>
   to_string(buffer<char_t> &&b)
@@ -244,6 +453,203 @@ namespace clon::fmt
   {
     make_partial(fmt, args...).format(ctx);
   }
+  // formats into out without allocating : size is the length the whole
+  // text would have, more than out.size() when it is truncated.
+  template <typename char_t>
+  struct format_to_n_result
+  {
+    char_t *out;
+    std::size_t size;
+    bool truncated;
+  };
+
+  template <typename char_t>
+  format_to_n_result<char_t> make_to_n_result(
+      std::span<char_t> out,
+      const formatter_context<char_t> &ctx)
+  {
+    const std::size_t written = ctx.pending().size();
+    return {out.data() + written, written + ctx.dropped(), ctx.dropped() != 0};
+  }
+
+  template <typename... args_t>
+  format_to_n_result<char> format_to_n(
+      std::span<char> out,
+      view<char> fmt, const args_t &...args)
+  {
+    formatter_context<char> ctx{out};
+    format_into(ctx, fmt, args...);
+    return make_to_n_result(out, ctx);
+  }
+
+  template <typename... args_t>
+  format_to_n_result<wchar_t> format_to_n(
+      std::span<wchar_t> out,
+      view<wchar_t> fmt, const args_t &...args)
+  {
+    formatter_context<wchar_t> ctx{out};
+    format_into(ctx, fmt, args...);
+    return make_to_n_result(out, ctx);
+  }
+
+  template <literal lit, typename... args_t>
+    requires compiled_for<lit, args_t...>
+  format_to_n_result<typename compiled_pattern<lit>::char_type> format_to_n(
+      std::span<typename compiled_pattern<lit>::char_type> out,
+      compiled_pattern<lit> p, const args_t &...args)
+  {
+    formatter_context ctx{out};
+    format_into(ctx, p, args...);
+    return make_to_n_result(out, ctx);
+  }
+
+  inline void handle_unwritten()
+  {
+    throw std::runtime_error("unable to write the formatted text");
+  }
+
+  // formats through a block of block_size chars given to writer once
+  // full, on flush() and when destroyed. writer returns false when the
+  // chars could not be written, flush then throws and the block is
+  // dropped, so that it is not written twice. the destructor throws
+  // nothing : a failed last write is lost.
+  template <typename char_t, typename writer_t, std::size_t block_size = 4096>
+  class block_context : public formatter_context<char_t>
+  {
+    std::array<char_t, block_size> block;
+    writer_t writer;
+
+  public:
+    template <typename... args_t>
+    explicit block_context(args_t &&...args)
+        : formatter_context<char_t>(block, this, write_block),
+          writer{std::forward<args_t>(args)...} {}
+
+    block_context(const block_context &) = delete;
+    block_context &operator=(const block_context &) = delete;
+
+    ~block_context()
+    {
+      try
+      {
+        writer(this->pending());
+      }
+      catch (...)
+      {
+      }
+    }
+
+  private:
+    static void write_block(formatter_context<char_t> &ctx, void *sink)
+    {
+      block_context &self = *static_cast<block_context *>(sink);
+      const std::span<const char_t> data = ctx.pending();
+      ctx.rewind();
+
+      if (not self.writer(data))
+        handle_unwritten();
+    }
+  };
+
+  struct file_writer
+  {
+    std::FILE *file;
+
+    bool operator()(std::span<const char> data) const
+    {
+      return std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    }
+  };
+
+  template <typename char_t>
+  struct ostream_writer
+  {
+    std::basic_ostream<char_t> &os;
+
+    bool operator()(std::span<const char_t> data) const
+    {
+      os.write(data.data(), data.size());
+      return static_cast<bool>(os);
+    }
+  };
+
+  template <std::size_t block_size = 4096>
+  using file_context = block_context<char, file_writer, block_size>;
+
+  template <typename char_t, std::size_t block_size = 4096>
+  using ostream_context = block_context<char_t, ostream_writer<char_t>, block_size>;
+
+#ifdef CLON_FMT_HAS_FD
+  struct fd_writer
+  {
+    int fd;
+
+    bool operator()(std::span<const char> data) const
+    {
+      while (not data.empty())
+      {
+        const ::ssize_t written = ::write(fd, data.data(), data.size());
+
+        if (written < 0)
+          return false;
+
+        data = data.subspan(written);
+      }
+
+      return true;
+    }
+  };
+
+  template <std::size_t block_size = 4096>
+  using fd_context = block_context<char, fd_writer, block_size>;
+#endif
+
+  // format_to appends to a sink : any formatter context (a block_context
+  // keeps its block until flushed), a buffer reused from call to call,
+  // an ostream or a FILE*, both flushed down to their device (os.flush(),
+  // fflush) before returning.
+  template <typename char_t, typename pattern_t, typename... args_t>
+  void format_to(
+      formatter_context<char_t> &sink,
+      const pattern_t &fmt, const args_t &...args)
+  {
+    format_into(sink, fmt, args...);
+  }
+
+  template <typename char_t, typename pattern_t, typename... args_t>
+  void format_to(
+      buffer<char_t> &sink,
+      const pattern_t &fmt, const args_t &...args)
+  {
+    formatter_context<char_t> ctx{sink};
+    format_into(ctx, fmt, args...);
+  }
+
+  template <typename char_t, typename pattern_t, typename... args_t>
+  void format_to(
+      std::basic_ostream<char_t> &sink,
+      const pattern_t &fmt, const args_t &...args)
+  {
+    ostream_context<char_t> ctx(sink);
+    format_into(ctx, fmt, args...);
+    ctx.flush();
+
+    if (not sink.flush())
+      handle_unwritten();
+  }
+
+  template <typename pattern_t, typename... args_t>
+  void format_to(
+      std::FILE *sink,
+      const pattern_t &fmt, const args_t &...args)
+  {
+    file_context<> ctx(sink);
+    format_into(ctx, fmt, args...);
+    ctx.flush();
+
+    if (std::fflush(sink) != 0)
+      handle_unwritten();
+  }
 } // namespace clon::fmt
 
 #endif
@@ -1,9 +1,16 @@
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <cstdio>
 
 #include "format.hpp"
 #include "test.hpp"
 
 using namespace clon::fmt;
+using namespace clon::fmt::literals;
+
+template <typename... args_t>
+concept two_placeholders = requires(args_t... args) { format("{}-{}"_fmt, args...); };
 
 void should_format()
 {
@@ -13,9 +20,189 @@ void should_format()
   test_equals(format("{}{}{}{}", 1, 2, 3), "123");
   test_equals(format("{}_{}", std::string("co"), std::string("co")), "co_co");
   test_equals(format("{}", std::vector<char>({'c', 'o', 'u'})), "cou");
+  test_equals(format("{};{}", 0.1, -2.5e-3), "0.1;-0.0025");
+  test_equals(format("{}", 1e300), "1e+300");
+  test_equals(format("{};{};{}", 1500.0, -2.0, 0.0), "1500.0;-2.0;0.0");
+  test_equals(length_of(1500.0), 6);
+  test_catch(format("{}", std::numeric_limits<double>::quiet_NaN()), format_error);
+  test_catch(format("{}", -std::numeric_limits<double>::infinity()), format_error);
+}
+
+void should_format_compiled()
+{
+  test_equals(format("{};{};{}"_fmt, 1, 2, 3), "1;2;3");
+  test_equals(format("({} \"{}\")"_fmt, std::string("name"), std::string("Paul")), "(name \"Paul\")");
+  test_equals(format("no placeholder"_fmt), "no placeholder");
+  test_equals(format("{}{}"_fmt, 0.5, std::vector<char>({'c', 'o'})), "0.5co");
+  test_equals(format(L"{}!"_fmt, std::wstring(L"w")) == L"w!", true);
+  test_equals(predict_length_of("{}-{}"_fmt, 12, 3), 4);
+  test_equals(format("{}-{}"_fmt, 12, 3), format("{}-{}", 12, 3));
+
+  static_assert(two_placeholders<int, int>);
+  static_assert(not two_placeholders<int>);
+  static_assert(not two_placeholders<int, int, int>);
+}
+
+void should_format_into_span()
+{
+  char out[8];
+
+  auto res = format_to_n(out, "{}-{}", 12, std::string("ab"));
+  test_equals(std::string_view(out, res.out), "12-ab");
+  test_equals(res.size, 5);
+  test_equals(res.truncated, false);
+
+  res = format_to_n(out, "{} is {}"_fmt, std::string("name"), std::string("Paul"));
+  test_equals(std::string_view(out, res.out), "name is ");
+  test_equals(res.size, 12);
+  test_equals(res.truncated, true);
+}
+
+void should_format_to_fd()
+{
+  int fds[2];
+  test_equals(::pipe(fds), 0);
+
+  {
+    fd_context<4> ctx(fds[1]);
+    format_into(ctx, "{};{}"_fmt, std::string("abcdefghij"), 42);
+    format_into(ctx, "!");
+  }
+
+  ::close(fds[1]);
+
+  char in[32];
+  const ::ssize_t got = ::read(fds[0], in, sizeof(in));
+  ::close(fds[0]);
+
+  test_equals(std::string_view(in, got), "abcdefghij;42!");
+}
+
+void should_format_integers()
+{
+  test_equals(format("{};{};{}", -1, -42, -1234567), "-1;-42;-1234567");
+  test_equals(format("{}", std::numeric_limits<long long>::min()), "-9223372036854775808");
+  test_equals(format("{}", std::numeric_limits<unsigned long long>::max()), "18446744073709551615");
+  test_equals(format("{};{};{}", 0, 9, 10), "0;9;10");
+  test_equals(format("{}", short(-32768)), "-32768");
+  test_equals(format(L"{}", -907) == L"-907", true);
+
+  for (long long i = 1; i < 1000000000000000000; i *= 10)
+    for (long long v : {i - 1, i, -i, i + 1})
+      test_equals(length_of(v), format("{}", v).size());
+
+  test_equals(format("{}", hex(255)), "ff");
+  test_equals(format("{}", hex(255u, 8)), "000000ff");
+  test_equals(format("{}", with(-5, {.width = 4, .fill = '0'})), "-005");
+  test_equals(format("{}", with(-5, {.width = 4})), "  -5");
+  test_equals(format("{}", with(-1.5, {.width = 6, .fill = '0'})), "-001.5");
+  test_equals(format("{}", with(-1.5, {.width = 6})), "  -1.5");
+  test_equals(format("{}", with(1.5, {.width = 6, .fill = '0'})), "0001.5");
+  test_equals(format("{}", with(5, {.base = 2})), "101");
+  test_equals(format("{}", with(std::string("ab"), {.width = 4, .fill = '.'})), "..ab");
+  test_equals(length_of(with(1234, {.width = 2})), 4);
+  test_equals(length_of(hex(-255, 4)), 4);
+  test_equals(format("{}", with(35, {.base = 36})), "z");
+
+  const auto h = hex(255, 4);
+  const auto w = with(-1.5, {.width = 6});
+  test_equals(format("{};{}", h, w), "00ff;  -1.5");
+}
+
+void should_reject_bad_bases()
+{
+  const int ten = 10;
+  test_catch(with(ten, {.base = 0}), format_error);
+  test_catch(with(ten, {.base = 1}), format_error);
+  test_catch(with(ten, {.base = 37}), format_error);
+  test_catch(with(ten, {.base = 256}), format_error);
+  test_catch(format("{}", specified<int>{ten, {.base = 0}}), format_error);
+  test_catch(length_of(specified<int>{ten, {.base = 37}}), format_error);
+}
+
+void should_format_to_sinks()
+{
+  std::string buff;
+  format_to(buff, "{}-"_fmt, 1);
+  format_to(buff, "{}", 2);
+  test_equals(buff, "1-2");
+
+  buff.clear();
+  format_to(buff, "{}", hex(10));
+  test_equals(buff, "a");
+
+  std::ostringstream os;
+  format_to(os, "{} {}", std::string("to"), 42);
+  test_equals(os.str(), "to 42");
+
+  std::FILE *file = std::tmpfile();
+
+  {
+    file_context<8> ctx(file);
+    format_to(ctx, "{};{}"_fmt, std::string("abcdefghijklmnop"), -7);
+    ctx.flush();
+    test_equals(std::ftell(file), 19);
+    format_to(ctx, "!");
+  }
+
+  format_to(file, "{}", 0.5);
+
+  char in[32];
+  std::rewind(file);
+  const std::size_t got = std::fread(in, 1, sizeof(in), file);
+  std::fclose(file);
+
+  test_equals(std::string_view(in, got), "abcdefghijklmnop;-7!0.5");
+}
+
+// fails its first write, then throws on any write of more than 2 chars.
+struct flaky_writer
+{
+  std::string &out;
+  std::size_t calls = 0;
+
+  bool operator()(std::span<const char> data)
+  {
+    if (calls++ == 0)
+      return false;
+
+    if (data.size() > 2)
+      throw std::runtime_error("flaky");
+
+    out.append(data.data(), data.size());
+    return true;
+  }
+};
+
+void should_drop_unwritten_blocks()
+{
+  std::string out;
+
+  {
+    block_context<char, flaky_writer, 4> ctx(out);
+    test_catch(format_to(ctx, "abcdef"), std::runtime_error);
+    test_equals(ctx.pending().size(), 0);
+    format_to(ctx, "gh");
+  }
+
+  test_equals(out, "gh");
+
+  {
+    block_context<char, flaky_writer, 4> ctx(out, std::size_t(1));
+    format_to(ctx, "ijk");
+  }
+
+  test_equals(out, "gh");
 }
 
 int main(int argc, char **argv)
 {
   run_test(should_format);
+  run_test(should_format_integers);
+  run_test(should_reject_bad_bases);
+  run_test(should_format_compiled);
+  run_test(should_format_into_span);
+  run_test(should_format_to_fd);
+  run_test(should_format_to_sinks);
+  run_test(should_drop_unwritten_blocks);
 }
\ No newline at end of file